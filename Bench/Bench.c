@@ -0,0 +1,298 @@
+/**
+ * @file    Bench.c
+ * @author  严嘉哲
+ * @brief   热路径机器周期基准测试 (在 ucsim/s51 中运行，结果经串口输出 CSV)
+ * @version 1.0
+ * @date    2026-10-16
+ *
+ * 输出格式: suite,name,samples,min,avg,max (单位: 机器周期)
+ *   call : 单次函数调用 (Lexer_ProcessChar / Calc_PushOp ...)
+ *   expr : 整条表达式按 main.c 的按键流程处理 (不含 LCD)
+ *   d2s  : 单个数值的 Double2String 转换，name 为转换结果
+ *   d2s_ref : 同一数值用旧版 (除法取数) 实现转换，用于对比
+ *   num  : 当前数值后端 (NUM_BACKEND) 的单次运算，按接口汇总全部操作数对
+ *   num_ref : 同样操作数直接用 f64 软件浮点运算，用于对比
+ */
+#include "../Middleware/Common.h"
+#include "../Middleware/Lexer.h"
+#include "../Middleware/Parser.h"
+#include "../Middleware/Double2Str.h"
+#include "../Middleware/Num.h"
+#include "Double2StrRef.h"
+#include "CycleCounter.h"
+#include "BenchReport.h"
+
+// ============================================================
+// 1. 测试语料
+// ============================================================
+static char code * code ExprCorpus[] = {
+    "1+2=",
+    "12*34+5=",
+    "(1+2)*3=",
+    "3.14159*2=",
+    "100/7=",
+    "-5+12.5=",
+    "((2+3)*(4-1))/5=",
+    "123456*789=",
+    "0.1+0.2=",
+    "1/3*3=",
+    "9.99*9.99-0.01=",
+    "2*(3+4)*(5-6)=",
+};
+#define EXPR_COUNT (sizeof(ExprCorpus) / sizeof(ExprCorpus[0]))
+
+static f64 code ValueCorpus[] = {
+    0.0, 1.0, -1.0, 0.5, 3.1415926, 99.99, 12345.678,
+    -0.000123, 0.0000001, 1234567.0, -98765.43, 2000000000.0,
+    3.5e12, 6.02e23, -1.6e-19       // 超出 long 范围，旧实现 (d2s_ref) 输出无意义，仅对比耗时
+};
+#define VALUE_COUNT (sizeof(ValueCorpus) / sizeof(ValueCorpus[0]))
+
+// 数值后端的操作数对: a = a_sign * a_mant * 10^a_exp，b 同理
+// 指数均 <= 0，数值都在定点后端的默认范围 (±214748.3647) 以内
+typedef struct {
+    char *name;
+    s8  a_sign; u32 a_mant; s8 a_exp;
+    s8  b_sign; u32 b_mant; s8 b_exp;
+} NumPair;
+
+static NumPair code NumCorpus[] = {
+    { "small",   1, 12,      0,  1, 34,      0 },   // 12 op 34
+    { "frac",    1, 314159, -5,  1, 2,       0 },   // 3.14159 op 2
+    { "mixed",  -1, 5,       0,  1, 125,    -1 },   // -5 op 12.5
+    { "cents",   1, 999,    -2,  1, 999,    -2 },   // 9.99 op 9.99
+    { "large",   1, 123456,  0,  1, 789,     0 },   // 123456 op 789
+    { "tiny",    1, 1,      -4,  1, 3,       0 },   // 0.0001 op 3
+    { "money",   1, 1999,   -2,  1, 1075,   -3 },   // 19.99 op 1.075
+};
+#define NUM_PAIR_COUNT (sizeof(NumCorpus) / sizeof(NumCorpus[0]))
+
+#define EXPR_REPEAT 3   // 每条表达式重复测量次数
+
+// ============================================================
+// 2. 统计项
+// ============================================================
+static BenchStat xdata st_lexer;
+static BenchStat xdata st_getval;
+static BenchStat xdata st_pushnum;
+static BenchStat xdata st_pushop;
+static BenchStat xdata st_d2s;
+static BenchStat xdata st_d2s_ref;
+static BenchStat xdata st_one;
+static BenchStat xdata st_num[4];
+static BenchStat xdata st_ref[4];
+
+static char code * code NumOpName[4] = { "Num_Add", "Num_Sub", "Num_Mul", "Num_Div" };
+static char code * code RefOpName[4] = { "f64_add", "f64_sub", "f64_mul", "f64_div" };
+
+static char xdata fmt_buf[24];
+static volatile f64 xdata ref_result;      // 保存对照运算的结果，避免被优化掉
+static char xdata name_buf[24];
+
+/**
+ * @brief  逐次测量一条表达式中各接口的单次调用开销
+ * @param  expr 表达式 (以 '=' 结尾)
+ * @return 无
+ */
+static void bench_calls(char *expr) {
+    TokenType token;
+    bit was_busy;
+    u8 ok, flags;
+    Num NUM_MEM val;
+
+    Calc_Reset();
+    Lexer_ResetAll();
+    for (; *expr; expr++) {
+        was_busy = (Lexer_GetState() != STATE_IDLE);
+
+        Cycle_Start();
+        token = Lexer_ProcessChar(*expr);
+        Stat_Add(&st_lexer, Cycle_Stop());
+
+        if (token == TOK_NUM || token == TOK_ERROR) continue;
+
+        if (was_busy) {
+            Cycle_Start();
+            flags = Lexer_GetCurrentNum(&val);
+            Stat_Add(&st_getval, Cycle_Stop());
+
+            Cycle_Start();
+            Calc_PushNum(&val, flags);
+            Stat_Add(&st_pushnum, Cycle_Stop());
+        }
+
+        Cycle_Start();
+        ok = Calc_PushOp(token);
+        Stat_Add(&st_pushop, Cycle_Stop());
+        if (!ok) break;
+    }
+}
+
+/**
+ * @brief  按 main.c 的按键流程处理整条表达式 (含数字预览与结果格式化，不含 LCD)
+ * @param  expr 表达式 (以 '=' 结尾)
+ * @return 无
+ */
+static void run_keys(char *expr) {
+    TokenType token;
+    bit was_busy;
+    u8 flags;
+    Num NUM_MEM val;
+
+    Calc_Reset();
+    Lexer_ResetAll();
+    for (; *expr; expr++) {
+        was_busy = (Lexer_GetState() != STATE_IDLE);
+        token = Lexer_ProcessChar(*expr);
+
+        if (token == TOK_NUM) {
+            Lexer_ToString(fmt_buf);
+            continue;
+        }
+        if (token == TOK_ERROR) continue;
+
+        if (was_busy) {
+            flags = Lexer_GetCurrentNum(&val);
+            Calc_PushNum(&val, flags);
+        }
+        if (!Calc_PushOp(token)) return;
+        if (token == TOK_END) {
+            Calc_GetResult(&val);
+            Num_ToString(&val, fmt_buf);
+        }
+    }
+}
+
+/**
+ * @brief  测量一对操作数在当前数值后端与 f64 软件浮点下的四则运算
+ * @param  p 操作数对
+ * @return 无
+ */
+static void bench_num(NumPair code *p) {
+    Num NUM_MEM a, b, r;
+    f64 fa, fb;
+    u8 op;
+
+    Cycle_Start();
+    Num_FromDigits(&a, p->a_sign, p->a_mant, p->a_exp);
+    Stat_Add(&st_getval, Cycle_Stop());
+    Num_FromDigits(&b, p->b_sign, p->b_mant, p->b_exp);
+
+    // 软件浮点的对照操作数取自同一十进制输入
+    fa = (f64)p->a_mant;
+    for (op = -p->a_exp; op > 0; op--) fa /= 10.0;
+    if (p->a_sign < 0) fa = -fa;
+    fb = (f64)p->b_mant;
+    for (op = -p->b_exp; op > 0; op--) fb /= 10.0;
+    if (p->b_sign < 0) fb = -fb;
+
+    for (op = 0; op < 4; op++) {
+        Stat_Reset(&st_one);
+        Cycle_Start();
+        switch (op) {
+            case 0: Num_Add(&r, &a, &b); break;
+            case 1: Num_Sub(&r, &a, &b); break;
+            case 2: Num_Mul(&r, &a, &b); break;
+            case 3: Num_Div(&r, &a, &b); break;
+        }
+        Stat_Add(&st_one, Cycle_Stop());
+        Stat_Add(&st_num[op], st_one.sum);
+
+        Cycle_Start();
+        switch (op) {
+            case 0: ref_result = fa + fb; break;
+            case 1: ref_result = fa - fb; break;
+            case 2: ref_result = fa * fb; break;
+            case 3: ref_result = fa / fb; break;
+        }
+        Stat_Add(&st_ref[op], Cycle_Stop());
+    }
+
+    // 格式化最后一次运算 (除法) 的结果
+    Cycle_Start();
+    Num_ToString(&r, fmt_buf);
+    Stat_Add(&st_d2s, Cycle_Stop());
+}
+
+/**
+ * @brief  基准测试结束点 (ucsim 在此处设断点停止仿真)
+ * @param  无
+ * @return 无
+ */
+void Bench_Done(void) {
+    while (1);
+}
+
+void main(void) {
+    u8 i;
+    u8 j;
+
+    Report_Init();
+    Cycle_Init();
+    Report_Header();
+
+    // --- 单次调用 ---
+    Stat_Reset(&st_lexer);
+    Stat_Reset(&st_getval);
+    Stat_Reset(&st_pushnum);
+    Stat_Reset(&st_pushop);
+    for (i = 0; i < EXPR_COUNT; i++) {
+        bench_calls(ExprCorpus[i]);
+    }
+    Report_Stat("call", "Lexer_ProcessChar", &st_lexer);
+    Report_Stat("call", "Lexer_GetCurrentNum", &st_getval);
+    Report_Stat("call", "Calc_PushNum", &st_pushnum);
+    Report_Stat("call", "Calc_PushOp", &st_pushop);
+
+    // --- Double2String (新旧实现对比) ---
+    Stat_Reset(&st_d2s);
+    Stat_Reset(&st_d2s_ref);
+    for (i = 0; i < VALUE_COUNT; i++) {
+        Stat_Reset(&st_one);
+        Cycle_Start();
+        Double2String(ValueCorpus[i], name_buf);
+        Stat_Add(&st_one, Cycle_Stop());
+        Stat_Add(&st_d2s, st_one.sum);
+        Report_Stat("d2s", name_buf, &st_one);
+
+        Stat_Reset(&st_one);
+        Cycle_Start();
+        Double2String_Ref(ValueCorpus[i], name_buf);
+        Stat_Add(&st_one, Cycle_Stop());
+        Stat_Add(&st_d2s_ref, st_one.sum);
+        Report_Stat("d2s_ref", name_buf, &st_one);
+    }
+    Report_Stat("call", "Double2String", &st_d2s);
+    Report_Stat("call", "Double2String_Ref", &st_d2s_ref);
+
+    // --- 数值后端 (与 f64 软件浮点对比) ---
+    Stat_Reset(&st_getval);
+    Stat_Reset(&st_d2s);
+    for (i = 0; i < 4; i++) {
+        Stat_Reset(&st_num[i]);
+        Stat_Reset(&st_ref[i]);
+    }
+    for (i = 0; i < NUM_PAIR_COUNT; i++) {
+        bench_num(&NumCorpus[i]);
+    }
+    for (i = 0; i < 4; i++) {
+        Report_Stat("num", NumOpName[i], &st_num[i]);
+        Report_Stat("num_ref", RefOpName[i], &st_ref[i]);
+    }
+    Report_Stat("num", "Num_FromDigits", &st_getval);
+    Report_Stat("num", "Num_ToString", &st_d2s);
+
+    // --- 整条表达式 ---
+    for (i = 0; i < EXPR_COUNT; i++) {
+        Stat_Reset(&st_one);
+        for (j = 0; j < EXPR_REPEAT; j++) {
+            Cycle_Start();
+            run_keys(ExprCorpus[i]);
+            Stat_Add(&st_one, Cycle_Stop());
+        }
+        Report_Stat("expr", ExprCorpus[i], &st_one);
+    }
+
+    Report_End();
+    Bench_Done();
+}
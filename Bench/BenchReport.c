@@ -0,0 +1,126 @@
+/**
+ * @file    BenchReport.c
+ * @author  严嘉哲
+ * @brief   基准测试统计与串口 CSV 输出
+ * @version 1.0
+ * @date    2026-10-16
+ */
+#include "../Drivers/MCU.h"
+#include "BenchReport.h"
+
+// ============================================================
+// 1. 统计
+// ============================================================
+
+/**
+ * @brief  清空统计项
+ * @param  st 统计项
+ * @return 无
+ */
+void Stat_Reset(BenchStat xdata *st) {
+    st->min = 0xFFFFFFFFUL;
+    st->max = 0;
+    st->sum = 0;
+    st->samples = 0;
+}
+
+/**
+ * @brief  记录一次测量
+ * @param  st     统计项
+ * @param  cycles 机器周期数
+ * @return 无
+ */
+void Stat_Add(BenchStat xdata *st, u32 cycles) {
+    if (cycles < st->min) st->min = cycles;
+    if (cycles > st->max) st->max = cycles;
+    st->sum += cycles;
+    st->samples++;
+}
+
+// ============================================================
+// 2. 串口输出 (SMOD=1, 4800bps，重装值由 MCU_CYCLE_HZ 推导)
+// ============================================================
+#define REPORT_BAUD     4800UL
+// SMOD=1 时波特率 = MCU_CYCLE_HZ / 16 / (256 - TH1)，四舍五入
+#define REPORT_TH1      (256 - (MCU_CYCLE_HZ / 16 + REPORT_BAUD / 2) / REPORT_BAUD)
+
+static void uart_putc(char c) {
+    SBUF = c;
+    while (!TI);
+    TI = 0;
+}
+
+static void uart_puts(char *s) {
+    while (*s) uart_putc(*s++);
+}
+
+static void uart_putu32(u32 v) {
+    char buf[11];
+    u8 i = 0;
+    do {
+        buf[i++] = (char)(v % 10) + '0';
+        v /= 10;
+    } while (v);
+    while (i) uart_putc(buf[--i]);
+}
+
+/**
+ * @brief  初始化串口 (Timer1 作波特率发生器)
+ * @param  无
+ * @return 无
+ */
+void Report_Init(void) {
+    SCON = 0x50;        // 模式 1，允许接收
+    PCON |= 0x80;       // SMOD = 1
+    TMOD &= 0x0F;
+    TMOD |= 0x20;       // Timer1: 8 位自动重装
+    TH1 = REPORT_TH1;   // 12MHz/12T 时为 0xF3
+    TL1 = REPORT_TH1;
+    TR1 = 1;
+    TI = 0;
+}
+
+/**
+ * @brief  输出 CSV 表头
+ * @param  无
+ * @return 无
+ */
+void Report_Header(void) {
+#if defined(SDCC_MODEL_LARGE)
+    uart_puts("# model=large num=" NUM_NAME " unit=machine_cycles\r\n");
+#else
+    uart_puts("# model=small num=" NUM_NAME " unit=machine_cycles\r\n");
+#endif
+    uart_puts("suite,name,samples,min,avg,max\r\n");
+}
+
+/**
+ * @brief  输出一条统计记录
+ * @param  suite 测试组
+ * @param  name  测试项 (表达式原文等，不含逗号)
+ * @param  st    统计项
+ * @return 无
+ */
+void Report_Stat(char *suite, char *name, BenchStat xdata *st) {
+    uart_puts(suite);
+    uart_putc(',');
+    uart_puts(name);
+    uart_putc(',');
+    uart_putu32(st->samples);
+    uart_putc(',');
+    uart_putu32(st->samples ? st->min : 0);
+    uart_putc(',');
+    uart_putu32(st->samples ? st->sum / st->samples : 0);
+    uart_putc(',');
+    uart_putu32(st->max);
+    uart_puts("\r\n");
+}
+
+/**
+ * @brief  输出结束标记 (运行脚本据此确认输出完整)
+ * @param  无
+ * @return 无
+ */
+void Report_End(void) {
+    uart_puts("# end\r\n");
+}
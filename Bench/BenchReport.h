@@ -0,0 +1,26 @@
+#ifndef __BENCHREPORT_H__
+#define __BENCHREPORT_H__
+
+#include "../Middleware/Common.h"
+#include "../Middleware/Num.h"
+
+/**
+ * @brief 单项统计 (单位: 机器周期)
+ */
+typedef struct {
+    u32 min;
+    u32 max;
+    u32 sum;
+    u16 samples;
+} BenchStat;
+
+void Stat_Reset(BenchStat xdata *st);
+void Stat_Add(BenchStat xdata *st, u32 cycles);
+
+// --- 串口输出 (CSV，一行一条记录) ---
+void Report_Init(void);
+void Report_Header(void);
+void Report_Stat(char *suite, char *name, BenchStat xdata *st);
+void Report_End(void);
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * @file    CycleCounter.c
+ * @author  严嘉哲
+ * @brief   Timer0 机器周期计数器，用于基准测试
+ * @version 1.0
+ * @date    2026-10-16
+ */
+#include "../Drivers/MCU.h"
+#include "CycleCounter.h"
+
+static volatile u16 data cycle_ovf = 0;    // Timer0 溢出次数 (周期数高 16 位)
+static u16 data cycle_bias = 0;            // Start/Stop 自身开销，测量结果中扣除
+
+/**
+ * @brief  Timer0 溢出中断，累加高 16 位
+ */
+void Cycle_Timer0_Isr(void) INTERRUPT(1)
+{
+    cycle_ovf++;
+}
+
+/**
+ * @brief  启动计数 (清零后开始)
+ * @param  无
+ * @return 无
+ */
+void Cycle_Start(void)
+{
+    TR0 = 0;
+    TH0 = 0;
+    TL0 = 0;
+    TF0 = 0;
+    cycle_ovf = 0;
+    TR0 = 1;
+}
+
+/**
+ * @brief  停止计数并返回经过的机器周期数
+ * @param  无
+ * @return u32 机器周期数 (已扣除 Start/Stop 开销)
+ */
+u32 Cycle_Stop(void)
+{
+    u32 cycles;
+    TR0 = 0;
+    // 停表后可能还有一个未处理的溢出
+    if (TF0) {
+        TF0 = 0;
+        cycle_ovf++;
+    }
+    cycles = ((u32)cycle_ovf << 16) | ((u16)TH0 << 8) | TL0;
+    return (cycles > cycle_bias) ? (cycles - cycle_bias) : 0;
+}
+
+/**
+ * @brief  初始化 Timer0 并标定 Start/Stop 的固定开销
+ * @param  无
+ * @return 无
+ */
+void Cycle_Init(void)
+{
+    TMOD &= 0xF0;
+    TMOD |= 0x01;       // Timer0: 16 位定时器
+    ET0 = 1;
+    EA = 1;
+
+    cycle_bias = 0;
+    Cycle_Start();
+    cycle_bias = (u16)Cycle_Stop();
+}
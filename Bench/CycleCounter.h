@@ -0,0 +1,18 @@
+#ifndef __CYCLECOUNTER_H__
+#define __CYCLECOUNTER_H__
+
+#include "../Middleware/Common.h"
+
+/**
+ * @brief  基于 Timer0 的机器周期计数器
+ *         Timer0 工作在 16 位定时模式，每个机器周期加一，
+ *         溢出由中断累加到高 16 位，得到 32 位周期数。
+ */
+void Cycle_Init(void);
+void Cycle_Start(void);
+u32  Cycle_Stop(void);
+
+// SDCC 要求中断函数原型在 main() 所在文件中可见
+void Cycle_Timer0_Isr(void) INTERRUPT(1);
+
+#endif
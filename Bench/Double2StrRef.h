@@ -0,0 +1,13 @@
+#ifndef __DOUBLE2STRREF_H__
+#define __DOUBLE2STRREF_H__
+
+#include "../Middleware/Double2Str.h"
+
+/**
+ * @brief 旧版 Double2String (除法取数)，输出与 Double2String 相同，用于周期对比
+ * @param f   传入的浮点数
+ * @param buf 输出缓冲区的指针 (建议长度至少为15字节)
+ */
+void Double2String_Ref(f64 f, char *buf);
+
+#endif
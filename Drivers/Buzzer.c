@@ -1,33 +1,44 @@
-#include <regx52.h>
+#include "MCU.h"
 #include "Buzzer.h"
-#include "Delay.h"
-#include "Timer1.h"
-#include "HappyBrithday.h"
 
-#define BUZZER_TONE_LEVELS   3
-#define BUZZER_TONE_NOTES    8
 #define BUZZER_TONE_PALETTE  4
 #define BUZZER_KEY_COUNT     24
+#define BUZZER_GAP_MS        20	// 音符之间的停顿
+#define BUZZER_QSIZE         4	// 必须为 2 的幂
 
-typedef struct {
-	unsigned char level;
-	unsigned char note;
-	unsigned char duration;
-} BuzzerToneSpec;
+SBIT(buzzer, 0xA0, 4);
 
-extern const unsigned char code ToneTH[BUZZER_TONE_LEVELS][BUZZER_TONE_NOTES];
-extern const unsigned char code ToneTL[BUZZER_TONE_LEVELS][BUZZER_TONE_NOTES];
+// 音调方波：Timer2 16 位自动重装，每次溢出翻转一次引脚，溢出频率为音调频率的 2 倍
+// 计数频率为 MCU_CYCLE_HZ，半周期计数 = MCU_CYCLE_HZ / 2 / 频率 (四舍五入)
+#define TONE(hz)	((unsigned int)(65536UL - (MCU_CYCLE_HZ + (hz)) / (2UL * (hz))))
 
-static volatile unsigned char toneLevel;
-static volatile unsigned char toneNote;
-static void Buzzer_PlayTone(unsigned char paletteIndex);
+// 按音高 (音区*8 + 唱名) 索引的重装值，0 和 8 不使用
+static unsigned int code ToneReload[16] = {
+	0,		TONE(392),	TONE(440),	TONE(494),	TONE(523),	TONE(587),	TONE(659),	TONE(740),	// 低音区 1-7 (G4 - F#5)
+	0,		TONE(784),	TONE(880),	TONE(988),	TONE(1047),	TONE(1175),	TONE(1319),	TONE(1480)	// 高音区 1-7 (G5 - F#6)
+};
+
+// 播放队列：Buzzer_Play 写入旋律地址，Buzzer_Service 在中断中依次播放
+static unsigned char code * xdata Buzzer_Queue[BUZZER_QSIZE];
+static volatile unsigned char data Buzzer_QHead = 0;	// 主程序写入位置
+static volatile unsigned char data Buzzer_QTail = 0;	// 中断读取位置
+
+// 以下状态只在中断中修改
+static unsigned char code * data Buzzer_Pos = 0;	// 当前旋律的下一个音符，0 表示空闲
+static unsigned char data Buzzer_Unit;			// 当前旋律的节拍单位 (毫秒)
+static unsigned int data Buzzer_Left = 0;		// 当前音符/停顿剩余毫秒数
+static bit Buzzer_InGap = 0;					// 正处于音符之后的停顿
+static volatile bit Buzzer_Active = 0;			// 正在播放旋律
 
-static const BuzzerToneSpec code TonePalette[BUZZER_TONE_PALETTE] = {
-	{0, 3, 50},
-	{0, 5, 50},
-	{0, 6, 50},
-	{1, 3, 100}
-};  // level, note, duration(ms)
+// 按键音：单音符旋律，节拍单位即音长
+static unsigned char code Click0[] = {50,  MELODY_NOTE(0, 3, 1), MELODY_END};
+static unsigned char code Click1[] = {50,  MELODY_NOTE(0, 5, 1), MELODY_END};
+static unsigned char code Click2[] = {50,  MELODY_NOTE(0, 6, 1), MELODY_END};
+static unsigned char code Click3[] = {100, MELODY_NOTE(1, 3, 1), MELODY_END};
+
+static unsigned char code * code TonePalette[BUZZER_TONE_PALETTE] = {
+	Click0, Click1, Click2, Click3
+};
 
 static const char code KeyToneMap[BUZZER_KEY_COUNT] = {
 	0, 0, 0, 1,
@@ -45,23 +56,102 @@ static const char code KeyToneMap[BUZZER_KEY_COUNT] = {
  */
 void Buzzer_Init(void)
 {
-	Timer1_Init();
-	TR1 = 0;
+	T2CON = 0x00;			// 16 位自动重装，定时模式，不使用 T2EX
+	TR2 = 0;
+	TF2 = 0;
+	ET2 = 1;				// 使能定时器2中断
+	PT2 = 1;				// 高优先级：翻转不被 Timer0 节拍中断推迟，音调无抖动
+	EA = 1;
+}
+
+/**
+ * @brief  旋律放入播放队列后立即返回，由 Timer0 节拍在后台播放 (队列满时丢弃)
+ * @param  melody 旋律数据 (格式见 Buzzer.h)
+ * @return 无
+ */
+void Buzzer_Play(unsigned char code *melody)
+{
+	unsigned char next = (Buzzer_QHead + 1) & (BUZZER_QSIZE - 1);
+	if(next == Buzzer_QTail)
+		return;
+	Buzzer_Queue[Buzzer_QHead] = melody;
+	Buzzer_QHead = next;
+}
+
+/**
+ * @brief  查询是否正在播放或有待播放的旋律
+ * @param  无
+ * @return 1 忙，0 空闲
+ */
+unsigned char Buzzer_IsBusy(void)
+{
+	return Buzzer_Active || Buzzer_QHead != Buzzer_QTail;
 }
 
 /**
- * @brief  播放指定音调
- * @param  paletteIndex 音调在 TonePalette 中的索引
+ * @brief  播放按键音 (正在播放其他声音时跳过，不排队，以免按键音滞后)
+ * @param  keyNumber 按键编号 0~23
  * @return 无
  */
 void Buzzer_KeySound(int keyNumber)
 {
 	if(keyNumber < 0 || keyNumber >= BUZZER_KEY_COUNT || KeyToneMap[keyNumber] < 0)
 		return;
+	if(Buzzer_IsBusy())
+		return;
+
+	Buzzer_Play(TonePalette[KeyToneMap[keyNumber]]);
+}
+
+/**
+ * @brief  推进播放进度，由 Timer0 中断每毫秒调用一次
+ *         切换音符时只改写 Timer2 重装值，每个音符结束后插入 BUZZER_GAP_MS 的停顿，旋律结束后取队列中的下一首
+ * @param  无
+ * @return 无
+ */
+void Buzzer_Service(void)
+{
+	unsigned char n, pitch;
 
-	PlayTone(
-        TonePalette[KeyToneMap[keyNumber]].level,
-        TonePalette[KeyToneMap[keyNumber]].note,
-        TonePalette[KeyToneMap[keyNumber]].duration
-    );
+	if(Buzzer_Left && --Buzzer_Left)
+		return;
+
+	if(Buzzer_Pos && !Buzzer_InGap) {	// 音符结束，进入停顿
+		TR2 = 0;
+		Buzzer_InGap = 1;
+		Buzzer_Left = BUZZER_GAP_MS;
+		return;
+	}
+	Buzzer_InGap = 0;
+
+	if(Buzzer_Pos == 0 || *Buzzer_Pos == MELODY_END) {	// 当前旋律结束
+		if(Buzzer_QHead == Buzzer_QTail) {
+			Buzzer_Pos = 0;
+			Buzzer_Active = 0;
+			return;
+		}
+		Buzzer_Pos = Buzzer_Queue[Buzzer_QTail];
+		Buzzer_QTail = (Buzzer_QTail + 1) & (BUZZER_QSIZE - 1);
+		Buzzer_Unit = *Buzzer_Pos++;
+		Buzzer_Active = 1;
+		if(*Buzzer_Pos == MELODY_END)
+			return;		// 空旋律，下个节拍再取
+	}
+
+	n = *Buzzer_Pos++;
+	pitch = n >> 4;
+	TR2 = 0;
+	if(pitch) {
+		// 每个音符只装载一次重装值，之后由硬件自动重装
+		RCAP2L = TL2 = (unsigned char)ToneReload[pitch];
+		RCAP2H = TH2 = (unsigned char)(ToneReload[pitch] >> 8);
+		TR2 = 1;
+	}
+	Buzzer_Left = (unsigned int)Buzzer_Unit * (n & 0x0F);
+}
+
+void Timer2_Isr(void) INTERRUPT(5)
+{
+	TF2 = 0;				// Timer2 的溢出标志需软件清除
+	buzzer = !buzzer;
 }
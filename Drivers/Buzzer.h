@@ -1,7 +1,24 @@
 #ifndef __BUZZER_H__
 #define __BUZZER_H__
 
+#include "../Middleware/Compiler.h"
+
+//旋律格式 (存放在 code 区)：
+//第 1 字节为节拍单位 (毫秒)，之后每个音符 1 字节：高 4 位音高，低 4 位时值 (节拍数 1~15)，以 MELODY_END 结束
+//音高 = 音区(0~1)*8 + 唱名(1~7)，0 为休止符
+#define MELODY_NOTE(level, note, len)	((unsigned char)((((level) * 8 + (note)) << 4) | (len)))
+#define MELODY_REST(len)				((unsigned char)(len))
+#define MELODY_END						0
+
 void Buzzer_Init(void);
 void Buzzer_KeySound(int keyNumber);
+void Buzzer_Play(unsigned char code *melody);
+unsigned char Buzzer_IsBusy(void);
+
+//仅供 Timer0 中断调用 (每毫秒一次)
+void Buzzer_Service(void);
+
+// SDCC 要求中断函数原型在 main() 所在文件中可见，否则不会生成中断向量
+void Timer2_Isr(void) INTERRUPT(5);
 
-#endif
\ No newline at end of file
+#endif
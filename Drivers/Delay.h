@@ -1,6 +0,0 @@
-#ifndef __DELAY_H__
-#define __DELAY_H__
-
-void Delay(unsigned int xms);
-
-#endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef __HAL_H__
+#define __HAL_H__
+
+/**
+ * @brief  硬件抽象层：驱动中直接操作引脚与特殊功能寄存器的几处原语
+ *         板上 (Keil/SDCC) 展开为内联的引脚操作，中断与主程序各自内联，不共用函数 (避免重入)；
+ *         主机编译时由 Host/VirtualDevice.c 实现，用于在 Linux 上运行 main.c
+ *         按键的原始读数由 MatrixKeyRead()/IndependentKeyRead() 提供，同样由虚拟设备替换
+ */
+#include "MCU.h"
+
+#if !defined(COMPILER_HOST)
+
+//LCD1602 引脚配置：
+SBIT(LCD_RS, 0xA0, 6);
+SBIT(LCD_RW, 0xA0, 5);
+SBIT(LCD_EN, 0xA0, 7);
+#define LCD_DataPort	P0
+
+#define PCON_IDL	0x01	//空闲模式：CPU 停止，定时器与中断继续运行
+#define PCON_PD		0x02	//掉电模式：振荡器停止，只能由外部中断 (P3.2/P3.3) 唤醒
+
+//EN 高电平宽度：HD44780 要求不小于 230ns (同时覆盖读数据的 160ns 延迟)，
+//置位后的下一条指令已保持一个机器周期，时钟较快时按机器周期数补 NOP
+#define LCD_EN_CYCLES	((MCU_CYCLE_HZ/1000UL*230UL+999999UL)/1000000UL)	//230ns 向上取整的机器周期数
+#if LCD_EN_CYCLES <= 1
+#define HAL_LcdEnHold()
+#elif LCD_EN_CYCLES == 2
+#define HAL_LcdEnHold()	NOP()
+#elif LCD_EN_CYCLES == 3
+#define HAL_LcdEnHold()	do{NOP();NOP();}while(0)
+#else
+#error "LCD_EN_CYCLES: add NOP()s to HAL_LcdEnHold for this clock"
+#endif
+
+//LCD1602 总线：写一个命令 (IsCmd=1) 或数据 (IsCmd=0) 字节
+#define HAL_LcdWrite(IsCmd,Value)	do{LCD_RS=(IsCmd)?0:1;LCD_RW=0;LCD_DataPort=(Value);LCD_EN=1;HAL_LcdEnHold();LCD_EN=0;}while(0)
+//LCD1602 总线：读忙标志 (D7) 到 Busy，准双向口先写1才能读入
+#define HAL_LcdReadBusy(Busy)	do{LCD_DataPort=0xFF;LCD_RS=0;LCD_RW=1;LCD_EN=1;HAL_LcdEnHold();Busy=(LCD_DataPort&0x80)?1:0;LCD_EN=0;LCD_RW=0;}while(0)
+//CPU 空闲模式 / 掉电模式
+#define HAL_Idle()		(PCON|=PCON_IDL)
+#define HAL_PowerDown()	(PCON|=PCON_PD)
+//忙等循环体：等待中断改变条件，板上什么也不做
+#define HAL_Poll()
+//延时循环消耗的时间 (微秒)：板上由循环本身消耗
+#define HAL_Spin(us)
+
+#else
+
+void HAL_LcdWrite(unsigned char IsCmd,unsigned char Value);
+unsigned char HAL_LcdBusy(void);
+#define HAL_LcdReadBusy(Busy)	((Busy)=HAL_LcdBusy())
+void HAL_Idle(void);
+void HAL_PowerDown(void);
+void HAL_Poll(void);	//虚拟时钟推进一个节拍
+void HAL_Spin(unsigned int us);	//虚拟时钟推进 us 微秒
+
+#endif
+
+#endif
@@ -1,8 +1,6 @@
 #ifndef __HAPPYBRITHDAY_H__
 #define __HAPPYBRITHDAY_H__
 
-void Timer1_Init(void);
-void PlayTone(unsigned char level, unsigned char note, unsigned char duration);
 void HappyBrithday();
 
-#endif
\ No newline at end of file
+#endif
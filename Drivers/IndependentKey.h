@@ -1,6 +1,6 @@
 #ifndef __INDEPENDENTKEY_H__
 #define __INDEPENDENTKEY_H__
 
-int IndependentKeyDown();
+unsigned char IndependentKeyRead();
 
-#endif
\ No newline at end of file
+#endif
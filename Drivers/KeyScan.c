@@ -0,0 +1,173 @@
+#include "MCU.h"
+#include "KeyScan.h"
+#include "Timer0.h"
+#include "MatrixKey.h"
+#include "IndependentKey.h"
+
+//按键按 8 个一组保存为位图：第 0、1 组为矩阵键盘，第 2 组为独立按键
+#define KEY_GROUPS	3
+#define KEY_NONE	0xFF
+
+//事件队列：Key_Scan 在中断中写入，主程序用 Key_GetEvent 读取
+#define KEY_QSIZE	16	//必须为 2 的幂
+
+static unsigned char xdata Key_Queue[KEY_QSIZE];
+static volatile unsigned char data Key_QHead=0;	//中断写入位置
+static volatile unsigned char data Key_QTail=0;	//主程序读取位置
+
+static unsigned char data Key_Stable[KEY_GROUPS];	//消抖后的按键状态，1 为按下
+static unsigned char data Key_Pending[KEY_GROUPS];	//计数未清零的按键 (正在确认中)
+static unsigned char xdata Key_Count[KEY_COUNT];	//原始状态与稳定状态不同的连续次数
+static unsigned char data Key_RepKey=KEY_NONE;	//最近按下、用于连发的键
+static unsigned int data Key_RepTime=0;		//该键已按住的时间 (毫秒)
+
+/**
+  * @brief  按键扫描初始化，启动 Timer0 节拍
+  * @param  无
+  * @retval 无
+  */
+void Key_Init()
+{
+	unsigned char i;
+	Key_QHead=Key_QTail=0;
+	for(i=0;i<KEY_GROUPS;i++)
+	{
+		Key_Stable[i]=0;
+		Key_Pending[i]=0;
+	}
+	for(i=0;i<KEY_COUNT;i++)Key_Count[i]=0;
+	Key_RepKey=KEY_NONE;
+	Timer0_Init();
+}
+
+/**
+  * @brief  以当前按键状态为稳定状态重新开始扫描，并清空事件队列
+  *         (掉电唤醒后调用，唤醒所用的按键不产生事件)
+  * @param  无
+  * @retval 无
+  */
+void Key_Resync()
+{
+	unsigned char i;
+	unsigned int m;
+	ET0=0;
+	m=MatrixKeyRead();
+	Key_Stable[0]=(unsigned char)m;
+	Key_Stable[1]=(unsigned char)(m>>8);
+	Key_Stable[2]=IndependentKeyRead();
+	for(i=0;i<KEY_GROUPS;i++)Key_Pending[i]=0;
+	for(i=0;i<KEY_COUNT;i++)Key_Count[i]=0;
+	Key_RepKey=KEY_NONE;
+	Key_QTail=Key_QHead;
+	ET0=1;
+}
+
+/**
+  * @brief  查询是否有按键处于按住状态
+  * @param  无
+  * @retval 1 有，0 无
+  */
+unsigned char Key_AnyDown()
+{
+	return (Key_Stable[0]|Key_Stable[1]|Key_Stable[2])!=0;
+}
+
+/**
+  * @brief  取出一个按键事件 (不等待)
+  * @param  无
+  * @retval 按键事件 (编号|KEY_REPEAT|KEY_MULTI)，无事件时返回-1
+  */
+int Key_GetEvent()
+{
+	unsigned char Event;
+	if(Key_QHead==Key_QTail)return -1;
+	Event=Key_Queue[Key_QTail];
+	Key_QTail=(Key_QTail+1)&(KEY_QSIZE-1);
+	return Event;
+}
+
+/**
+  * @brief  查询按键当前是否处于按住状态 (消抖后)
+  * @param  Key 按键编号 0~23
+  * @retval 1 按住，0 松开
+  */
+unsigned char Key_IsDown(unsigned char Key)
+{
+	return (Key_Stable[Key>>3]>>(Key&7))&1;
+}
+
+/**
+  * @brief  事件入队，队列满时丢弃 (16 个事件足够覆盖主程序最长的忙碌时间)
+  * @param  Event 按键事件
+  * @retval 无
+  */
+static void Key_Put(unsigned char Event)
+{
+	unsigned char next=(Key_QHead+1)&(KEY_QSIZE-1);
+	if(next==Key_QTail)return;
+	Key_Queue[Key_QHead]=Event;
+	Key_QHead=next;
+}
+
+/**
+  * @brief  扫描全部按键并消抖，产生按下/连发事件，由 Timer0 中断每毫秒调用一次
+  *         每个键独立计数，原始状态连续 KEY_DEBOUNCE_MS 与稳定状态不同才翻转，
+  *         因此多个键可以同时按下，各自产生事件
+  * @param  无
+  * @retval 无
+  */
+void Key_Scan()
+{
+	unsigned char Raw[KEY_GROUPS];
+	unsigned char g,b,Bit,Key,Diff,Held;
+	unsigned int m;
+
+	m=MatrixKeyRead();
+	Raw[0]=(unsigned char)m;
+	Raw[1]=(unsigned char)(m>>8);
+	Raw[2]=IndependentKeyRead();
+
+	for(g=0;g<KEY_GROUPS;g++)
+	{
+		Diff=Raw[g]^Key_Stable[g];
+		if((Diff|Key_Pending[g])==0)continue;	//本组无变化，跳过逐位处理
+		for(b=0,Bit=1;b<8;b++,Bit<<=1)
+		{
+			Key=(g<<3)|b;
+			if(!(Diff&Bit))
+			{
+				Key_Count[Key]=0;	//抖动：回到稳定状态，重新计数
+				Key_Pending[g]&=~Bit;
+				continue;
+			}
+			Key_Pending[g]|=Bit;
+			if(++Key_Count[Key]<KEY_DEBOUNCE_MS/KEY_SCAN_MS)continue;
+
+			Key_Count[Key]=0;
+			Key_Pending[g]&=~Bit;
+			Held=Key_Stable[0]|Key_Stable[1]|Key_Stable[2];
+			Key_Stable[g]^=Bit;
+			if(Key_Stable[g]&Bit)
+			{
+				Key_Put(Held?(Key|KEY_MULTI):Key);	//新按下
+				Key_RepKey=Key;
+				Key_RepTime=0;
+			}
+			else if(Key==Key_RepKey)
+			{
+				Key_RepKey=KEY_NONE;	//连发键松开
+			}
+		}
+	}
+
+	//连发：只针对最近按下且仍按住的键
+	if(Key_RepKey!=KEY_NONE)
+	{
+		Key_RepTime+=KEY_SCAN_MS;
+		if(Key_RepTime>=KEY_REPEAT_DELAY_MS)
+		{
+			Key_Put(Key_RepKey|KEY_REPEAT);
+			Key_RepTime=KEY_REPEAT_DELAY_MS-KEY_REPEAT_RATE_MS;
+		}
+	}
+}
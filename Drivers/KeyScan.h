@@ -0,0 +1,25 @@
+#ifndef __KEYSCAN_H__
+#define __KEYSCAN_H__
+
+//时间参数 (毫秒)：
+#define KEY_SCAN_MS		1	//扫描周期 (由 Timer0 毫秒节拍调用)
+#define KEY_DEBOUNCE_MS	10	//状态连续保持该时长才确认按下/松开
+#define KEY_REPEAT_DELAY_MS	500	//按住多久后开始连发
+#define KEY_REPEAT_RATE_MS	100	//连发间隔
+
+//按键事件：低 5 位为按键编号 (0~15 矩阵键盘，16~23 独立按键)，高位为标志
+#define KEY_COUNT		24
+#define KEY_CODE_MASK	0x1F
+#define KEY_REPEAT		0x40	//按住不放产生的连发事件
+#define KEY_MULTI		0x80	//按下时已有其他键处于按住状态 (组合键)
+
+void Key_Init();
+int Key_GetEvent();
+unsigned char Key_IsDown(unsigned char Key);
+unsigned char Key_AnyDown();
+void Key_Resync();
+
+//仅供 Timer0 中断调用
+void Key_Scan();
+
+#endif
@@ -1,15 +1,58 @@
-#include <REGX52.H>
+#include "MCU.h"
+#include "HAL.h"
 #include "LCD1602.h"
+#include "Timer0.h"
 
-//引脚配置：
-sbit LCD_RS=P2^6;
-sbit LCD_RW=P2^5;
-sbit LCD_EN=P2^7;
-#define LCD_DataPort P0
+//引脚配置与总线读写见 HAL.h
+
+//时序模式：
+//1 读忙标志 (RW=1) 判断液晶是否空闲，超时则自动回退到固定延时
+//0 始终使用固定延时
+#ifndef LCD_USE_BUSY_FLAG
+#define LCD_USE_BUSY_FLAG	1
+#endif
+#define LCD_BUSY_TIMEOUT	(MCU_US_TO_CYCLES(10000)/10)	//轮询次数上限 (每次约 10 个机器周期，共约 10ms，远大于清屏的 1.52ms)
+
+//延时循环次数 (DJNZ 每次 2 个机器周期)：
+#define LCD_DELAY_LOOPS	(MCU_US_TO_CYCLES(1000)/2)	//1ms
+#define LCD_SHORT_LOOPS	(MCU_US_TO_CYCLES(50)/2)	//50us
+
+static bit LCD_BusyOk=0;	//忙标志可用 (初始化完成且未超时)
+static bit LCD_PrevLong=0;	//上一条是清屏/归位等长指令 (固定延时模式下需等待更久)
+
+//显存镜像：
+//DDRAM 每行 40 个单元，屏幕显示其中从 LCD_HaveShift 开始的 16 列
+#define LCD_ROWS	2
+#define LCD_COLS	16
+#define LCD_DDRAM_COLS	40
+
+static char xdata LCD_Want[LCD_ROWS][LCD_DDRAM_COLS];	//期望的 DDRAM 内容
+static char xdata LCD_Have[LCD_ROWS][LCD_DDRAM_COLS];	//液晶实际的 DDRAM 内容
+static unsigned char xdata LCD_WantShift=0;		//期望的显示窗口起始列
+static unsigned char xdata LCD_HaveShift=0;		//液晶实际的显示窗口起始列
+static unsigned char xdata LCD_AC=0;			//液晶地址计数器 (写数据后自动加一)
+
+#if LCD_ASYNC
+//后台写入队列：LCD_Flush 入队，Timer0 中断每个节拍发送一个字节
+#define LCD_QSIZE	64	//必须为 2 的幂
+#define LCD_LONG_TICKS	((1520+TIMER0_TICK_US-1)/TIMER0_TICK_US)	//清屏/归位后等待的节拍数 (> 1.52ms)
+#define LCD_BUSY_TICKS	(10000/TIMER0_TICK_US)	//连续忙的节拍数上限 (约 10ms)，超过则认为忙标志不可用
+
+typedef struct {
+	unsigned char IsCmd;	//1 命令，0 数据
+	unsigned char Value;
+} LCD_Op;
+
+static LCD_Op xdata LCD_Queue[LCD_QSIZE];
+static volatile unsigned char data LCD_QHead=0;	//主程序写入位置
+static volatile unsigned char data LCD_QTail=0;	//中断读取位置
+static unsigned char data LCD_Hold=0;		//中断中剩余的等待节拍
+static unsigned char data LCD_BusyTicks=0;	//中断中连续读到忙的节拍数
+#endif
 
 //函数定义：
 /**
-  * @brief  LCD1602延时函数，12MHz调用可延时1ms
+  * @brief  LCD1602延时函数，延时约1ms (循环次数由 MCU_CYCLE_HZ 推导)
   * @param  无
   * @retval 无
   */
@@ -17,62 +60,82 @@ void LCD_Delay()
 {
 	unsigned char i, j;
 
-	i = 2;
-	j = 239;
+	i = LCD_DELAY_LOOPS/256+1;
+	j = LCD_DELAY_LOOPS%256;
 	do
 	{
 		while (--j);
 	} while (--i);
+	HAL_Spin(1000);
 }
 
 /**
-  * @brief  LCD1602写命令
-  * @param  Command 要写入的命令
+  * @brief  LCD1602短延时，约延时50us (大于普通指令的 37us)
+  * @param  无
   * @retval 无
   */
-void LCD_WriteCommand(unsigned char Command)
+static void LCD_DelayShort()
 {
-	LCD_RS=0;
-	LCD_RW=0;
-	LCD_DataPort=Command;
-	LCD_EN=1;
-	LCD_Delay();
-	LCD_EN=0;
-	LCD_Delay();
+	unsigned char i=LCD_SHORT_LOOPS;
+	while(--i);
+	HAL_Spin(50);
 }
 
 /**
-  * @brief  LCD1602写数据
-  * @param  Data 要写入的数据
+  * @brief  等待液晶空闲 (在每次写入之前调用)
+  *         忙标志模式下轮询 BF，其余情况按上一条指令的类型延时
+  * @param  无
   * @retval 无
   */
-void LCD_WriteData(unsigned char Data)
+static void LCD_WaitReady()
 {
-	LCD_RS=1;
-	LCD_RW=0;
-	LCD_DataPort=Data;
-	LCD_EN=1;
-	LCD_Delay();
-	LCD_EN=0;
-	LCD_Delay();
+#if LCD_USE_BUSY_FLAG
+	unsigned int n;
+	bit busy;
+	if(LCD_BusyOk)
+	{
+		n=LCD_BUSY_TIMEOUT;
+		do
+		{
+			HAL_LcdReadBusy(busy);	//D7 为忙标志，D6~D0 为地址计数器
+		} while(busy && --n);
+		if(!busy)return;
+		LCD_BusyOk=0;	//读不到空闲 (RW 未接或液晶异常)，之后改用固定延时
+	}
+#endif
+	if(LCD_PrevLong)
+	{
+		LCD_Delay();
+		LCD_Delay();
+	}
+	else
+	{
+		LCD_DelayShort();
+	}
 }
 
 /**
-  * @brief  LCD1602设置光标位置
-  * @param  Line 行位置，范围：1~2
-  * @param  Column 列位置，范围：1~16
+  * @brief  LCD1602写命令
+  * @param  Command 要写入的命令
   * @retval 无
   */
-void LCD_SetCursor(unsigned char Line,unsigned char Column)
+void LCD_WriteCommand(unsigned char Command)
 {
-	if(Line==1)
-	{
-		LCD_WriteCommand(0x80|(Column-1));
-	}
-	else if(Line==2)
-	{
-		LCD_WriteCommand(0x80|(Column-1+0x40));
-	}
+	LCD_WaitReady();
+	HAL_LcdWrite(1,Command);
+	LCD_PrevLong=(Command<=0x03);	//0x01 清屏、0x02/0x03 归位需要 1.52ms
+}
+
+/**
+  * @brief  LCD1602写数据
+  * @param  Data 要写入的数据
+  * @retval 无
+  */
+void LCD_WriteData(unsigned char Data)
+{
+	LCD_WaitReady();
+	HAL_LcdWrite(0,Data);
+	LCD_PrevLong=0;
 }
 
 /**
@@ -82,14 +145,50 @@ void LCD_SetCursor(unsigned char Line,unsigned char Column)
   */
 void LCD_Init()
 {
+	unsigned char r,c;
+	//上电复位期间忙标志不可读，初始化指令使用固定延时
+	LCD_BusyOk=0;
+	LCD_PrevLong=1;
 	LCD_WriteCommand(0x38);//八位数据接口，两行显示，5*7点阵
 	LCD_WriteCommand(0x0c);//显示开，光标关，闪烁关
 	LCD_WriteCommand(0x06);//数据读写操作后，光标自动加一，画面不动
 	LCD_WriteCommand(0x01);//光标复位，清屏
+	LCD_BusyOk=LCD_USE_BUSY_FLAG;
+#if LCD_ASYNC
+	//清屏尚未完成，第一个后台字节之前先等够时间
+	LCD_QHead=0;
+	LCD_QTail=0;
+	LCD_Hold=LCD_LONG_TICKS;
+	LCD_BusyTicks=0;
+	Timer0_Init();
+#endif
+	//清屏后 DDRAM 全为空格，窗口与地址计数器归零
+	for(r=0;r<LCD_ROWS;r++)
+	{
+		for(c=0;c<LCD_DDRAM_COLS;c++)
+		{
+			LCD_Want[r][c]=' ';
+			LCD_Have[r][c]=' ';
+		}
+	}
+	LCD_WantShift=0;
+	LCD_HaveShift=0;
+	LCD_AC=0;
+}
+
+/**
+  * @brief  可见坐标转换为 DDRAM 列号 (考虑显示窗口偏移)
+  * @param  Column 可见列位置，范围：1~16
+  * @retval DDRAM 列号，范围：0~39
+  */
+static unsigned char LCD_DdramCol(unsigned char Column)
+{
+	unsigned char c=LCD_WantShift+Column-1;
+	return (c>=LCD_DDRAM_COLS)?(c-LCD_DDRAM_COLS):c;
 }
 
 /**
-  * @brief  在LCD1602指定位置上显示一个字符
+  * @brief  在LCD1602指定位置上显示一个字符 (写入显存镜像，LCD_Flush 时发送)
   * @param  Line 行位置，范围：1~2
   * @param  Column 列位置，范围：1~16
   * @param  Char 要显示的字符
@@ -97,12 +196,12 @@ void LCD_Init()
   */
 void LCD_ShowChar(unsigned char Line,unsigned char Column,char Char)
 {
-	LCD_SetCursor(Line,Column);
-	LCD_WriteData(Char);
+	if(Line<1 || Line>LCD_ROWS || Column<1 || Column>LCD_COLS)return;
+	LCD_Want[Line-1][LCD_DdramCol(Column)]=Char;
 }
 
 /**
-  * @brief  在LCD1602指定位置开始显示所给字符串
+  * @brief  在LCD1602指定位置开始显示所给字符串 (写入显存镜像，超出行尾部分丢弃)
   * @param  Line 起始行位置，范围：1~2
   * @param  Column 起始列位置，范围：1~16
   * @param  String 要显示的字符串
@@ -111,9 +210,208 @@ void LCD_ShowChar(unsigned char Line,unsigned char Column,char Char)
 void LCD_ShowString(unsigned char Line,unsigned char Column,char *String)
 {
 	unsigned char i;
-	LCD_SetCursor(Line,Column);
-	for(i=0;String[i]!='\0';i++)
+	for(i=0;String[i]!='\0' && Column+i<=LCD_COLS;i++)
+	{
+		LCD_ShowChar(Line,Column+i,String[i]);
+	}
+}
+
+/**
+  * @brief  整行显示字符串，行内剩余部分补空格
+  * @param  Line 行位置，范围：1~2
+  * @param  String 要显示的字符串
+  * @retval 无
+  */
+void LCD_ShowLine(unsigned char Line,char *String)
+{
+	unsigned char i;
+	for(i=1;i<=LCD_COLS;i++)
+	{
+		LCD_ShowChar(Line,i,(*String!='\0')?*String++:' ');
+	}
+}
+
+/**
+  * @brief  显示窗口移到新的起始列，两行的可见内容在显存镜像中随之搬移
+  * @param  Shift 新的窗口起始列，范围：0~39
+  * @retval 无
+  */
+static void LCD_MoveWindow(unsigned char Shift)
+{
+	static char xdata Tmp[LCD_COLS];
+	unsigned char r,i,c;
+
+	for(r=0;r<LCD_ROWS;r++)
 	{
-		LCD_WriteData(String[i]);
+		for(i=0;i<LCD_COLS;i++)
+		{
+			Tmp[i]=LCD_Want[r][LCD_DdramCol(i+1)];
+		}
+		for(i=0;i<LCD_COLS;i++)
+		{
+			c=Shift+i; if(c>=LCD_DDRAM_COLS)c-=LCD_DDRAM_COLS;
+			LCD_Want[r][c]=Tmp[i];
+		}
 	}
-}
\ No newline at end of file
+	LCD_WantShift=Shift;
+}
+
+/**
+  * @brief  整行显示字符串，超过 16 个字符时用显示移位滚动，只显示末尾 16 个字符
+  *         (移位对两行同时生效，另一行的可见内容保持不变)
+  * @param  Line 行位置，范围：1~2
+  * @param  String 要显示的字符串，最多保留末尾 40 个字符
+  * @retval 无
+  */
+void LCD_ShowLineTail(unsigned char Line,char *String)
+{
+	unsigned char len,shift,c;
+
+	if(Line<1 || Line>LCD_ROWS)return;
+	for(len=0;String[len]!='\0';len++);
+	if(len>LCD_DDRAM_COLS)
+	{
+		String+=len-LCD_DDRAM_COLS;
+		len=LCD_DDRAM_COLS;
+	}
+	shift=(len>LCD_COLS)?(len-LCD_COLS):0;
+	if(shift!=LCD_WantShift)
+	{
+		LCD_MoveWindow(shift);
+	}
+	//字符串固定从 DDRAM 第 0 列开始存放，滚动只需移动窗口
+	for(c=0;c<LCD_DDRAM_COLS;c++)
+	{
+		LCD_Want[Line-1][c]=(c<len)?String[c]:' ';
+	}
+}
+
+/**
+  * @brief  发送一个命令或数据字节 (异步模式下放入队列，队列满时等待中断腾出空间)
+  * @param  IsCmd 1 命令，0 数据
+  * @param  Value 要发送的字节
+  * @retval 无
+  */
+static void LCD_Put(unsigned char IsCmd,unsigned char Value)
+{
+#if LCD_ASYNC
+	unsigned char next=(LCD_QHead+1)&(LCD_QSIZE-1);
+	while(next==LCD_QTail)HAL_Poll();
+	LCD_Queue[LCD_QHead].IsCmd=IsCmd;
+	LCD_Queue[LCD_QHead].Value=Value;
+	LCD_QHead=next;
+#else
+	if(IsCmd)LCD_WriteCommand(Value);
+	else LCD_WriteData(Value);
+#endif
+}
+
+/**
+  * @brief  将显存镜像中变化的单元发送到液晶 (异步模式下只入队，立即返回)
+  *         连续的单元依靠地址计数器自动加一，不重复设置光标
+  * @param  无
+  * @retval 无
+  */
+void LCD_Flush()
+{
+	unsigned char r,c,addr,d;
+
+	//1.窗口移位：每条命令移动一列，取较短的方向
+	d=(LCD_WantShift>=LCD_HaveShift)?(LCD_WantShift-LCD_HaveShift):(LCD_WantShift+LCD_DDRAM_COLS-LCD_HaveShift);
+	if(d<=LCD_DDRAM_COLS/2)
+	{
+		for(;d>0;d--)LCD_Put(1,0x18);	//画面左移 (窗口右移)
+	}
+	else
+	{
+		for(d=LCD_DDRAM_COLS-d;d>0;d--)LCD_Put(1,0x1c);	//画面右移 (窗口左移)
+	}
+	LCD_HaveShift=LCD_WantShift;
+
+	//2.逐个单元比较，只发送变化的字符
+	for(r=0;r<LCD_ROWS;r++)
+	{
+		for(c=0;c<LCD_DDRAM_COLS;c++)
+		{
+			if(LCD_Want[r][c]==LCD_Have[r][c])continue;
+			addr=(r==0)?c:(0x40+c);
+			if(addr!=LCD_AC)
+			{
+				LCD_Put(1,0x80|addr);
+			}
+			LCD_Put(0,LCD_Want[r][c]);
+			LCD_Have[r][c]=LCD_Want[r][c];
+			//地址计数器：行尾 0x27 跳到 0x40，0x67 回到 0x00
+			LCD_AC=(addr==0x27)?0x40:((addr==0x67)?0x00:(addr+1));
+		}
+	}
+}
+
+/**
+  * @brief  等待后台队列发送完毕 (同步模式下直接返回)
+  * @param  无
+  * @retval 无
+  */
+void LCD_Wait()
+{
+#if LCD_ASYNC
+	while(LCD_QHead!=LCD_QTail)HAL_Poll();
+#endif
+}
+
+/**
+  * @brief  查询后台队列是否还有未发送的字节
+  * @param  无
+  * @retval 1 忙，0 空闲 (同步模式下恒为 0)
+  */
+unsigned char LCD_IsBusy()
+{
+#if LCD_ASYNC
+	return LCD_QHead!=LCD_QTail;
+#else
+	return 0;
+#endif
+}
+
+#if LCD_ASYNC
+/**
+  * @brief  后台发送一个字节，由 Timer0 中断每个节拍调用一次
+  *         (只在中断中使用，不与主程序共用写函数，避免重入)
+  * @param  无
+  * @retval 无
+  */
+void LCD_Service()
+{
+	unsigned char value;
+#if LCD_USE_BUSY_FLAG
+	bit busy;
+#endif
+
+	if(LCD_QHead==LCD_QTail)return;
+	if(LCD_Hold)
+	{
+		LCD_Hold--;
+		return;
+	}
+#if LCD_USE_BUSY_FLAG
+	if(LCD_BusyOk)
+	{
+		HAL_LcdReadBusy(busy);
+		if(busy)
+		{
+			if(++LCD_BusyTicks>=LCD_BUSY_TICKS)LCD_BusyOk=0;
+			return;
+		}
+		LCD_BusyTicks=0;
+	}
+#endif
+	value=LCD_Queue[LCD_QTail].Value;
+	HAL_LcdWrite(LCD_Queue[LCD_QTail].IsCmd,value);
+	//固定延时模式下，长指令之后多等几个节拍；普通指令一个节拍 (250us) 已足够
+	if(LCD_Queue[LCD_QTail].IsCmd && value<=0x03 && !LCD_BusyOk)
+	{
+		LCD_Hold=LCD_LONG_TICKS;
+	}
+	LCD_QTail=(LCD_QTail+1)&(LCD_QSIZE-1);
+}
+#endif
@@ -1,8 +1,23 @@
 #ifndef __LCD1602_H__
 #define __LCD1602_H__
 
+//1 后台发送：LCD_Flush 只把变化的字节放入队列，由 Timer0 中断逐个发送
+//0 同步发送：LCD_Flush 返回时已全部写入液晶
+#ifndef LCD_ASYNC
+#define LCD_ASYNC	1
+#endif
+
+//显示函数只修改显存镜像，调用 LCD_Flush() 后才把变化的单元发送到液晶
 void LCD_Init();
 void LCD_ShowChar(unsigned char Line,unsigned char Column,char Char);
 void LCD_ShowString(unsigned char Line,unsigned char Column,char *String);
+void LCD_ShowLine(unsigned char Line,char *String);
+void LCD_ShowLineTail(unsigned char Line,char *String);
+void LCD_Flush();
+void LCD_Wait();
+unsigned char LCD_IsBusy();
+
+//仅供 Timer0 中断调用
+void LCD_Service();
 
-#endif
\ No newline at end of file
+#endif
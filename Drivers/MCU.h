@@ -0,0 +1,47 @@
+#ifndef __MCU_H__
+#define __MCU_H__
+
+/**
+ * @brief  STC89C516 寄存器定义，按编译器选择对应的头文件
+ *         (Keil: regx52.h, SDCC: 8052.h, 主机: Host/HostSfr.h 中的普通变量)
+ */
+#include "../Middleware/Compiler.h"
+
+#if defined(COMPILER_SDCC)
+#include <8052.h>
+#elif defined(COMPILER_HOST)
+#include "../Host/HostSfr.h"
+#else
+#include <regx52.h>
+#endif
+
+/**
+ * @brief  时钟配置，所有延时循环次数、定时器重装值与音调表都由此在编译期推导
+ *         FOSC   晶振频率 (Hz)
+ *         CPU_6T 1 为 STC 6T 双倍速模式 (须在 STC-ISP 下载时同时勾选)，0 为标准 12T
+ *         可在编译命令中覆盖，例如 -DFOSC=24000000UL -DCPU_6T=1
+ */
+#ifndef FOSC
+#define FOSC	12000000UL
+#endif
+#ifndef CPU_6T
+#define CPU_6T	0
+#endif
+
+#if CPU_6T
+#define MCU_CLOCKS_PER_CYCLE	6
+#else
+#define MCU_CLOCKS_PER_CYCLE	12
+#endif
+
+//每秒机器周期数，同时也是定时器的计数频率 (6T 模式下定时器一并倍速)
+#define MCU_CYCLE_HZ	(FOSC / MCU_CLOCKS_PER_CYCLE)
+
+//微秒 -> 机器周期数 (向下取整)
+#define MCU_US_TO_CYCLES(us)	((MCU_CYCLE_HZ / 1000UL) * (us) / 1000UL)
+
+#if MCU_CYCLE_HZ < 500000UL || MCU_CYCLE_HZ > 5120000UL
+#error "MCU_CYCLE_HZ out of range: FOSC / (6 or 12) must be 0.5 ~ 5.12 MHz"
+#endif
+
+#endif
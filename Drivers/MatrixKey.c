@@ -1,49 +1,27 @@
-#include <regx52.h>
-#include "Delay.h"
+#include "MCU.h"
 #include "MatrixKey.h"
 
 #define GPIO_KEY P1
 
+//列线 (低 4 位) 读数取反后到列号位图的映射：P1.3 为第 0 列 ... P1.0 为第 3 列
+static unsigned char code ColBits[16] = {
+	0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE,
+	0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF
+};
 
 /**
- * @brief  扫描矩阵键盘
+ * @brief  逐行扫描矩阵键盘，读取当前所有按键的原始状态 (不消抖、不等待)
  * @param  None
- * @return 按键值(0~15)，无按键按下时返回-1 
+ * @return 按键位图，第 n 位为 1 表示按键 n(0~15) 按下
  */
-int MatrixKeyDown() {
-    char a = 0;
-    int KeyValue = -1;
-	GPIO_KEY=0x0f;
-	if(GPIO_KEY!=0x0f) 		//读取按键是否按下
-	{
-		Delay(20);			//延时20ms消抖动
-		if(GPIO_KEY!=0x0f)  //再次检测键盘是否按下
-		{	
-			//测试列
-			GPIO_KEY=0X0F;
-			switch(GPIO_KEY)
-			{
-				case(0X07):	KeyValue=0;break;
-				case(0X0b):	KeyValue=1;break;
-				case(0X0d): KeyValue=2;break;
-				case(0X0e):	KeyValue=3;break;
-			}
-			//测试行
-			GPIO_KEY=0XF0;
-			switch(GPIO_KEY)
-			{
-				case(0X70):	KeyValue=KeyValue;break;
-				case(0Xb0):	KeyValue=KeyValue+4;break;
-				case(0Xd0): KeyValue=KeyValue+8;break;
-				case(0Xe0):	KeyValue=KeyValue+12;break;
-			}
-			
-		}
+unsigned int MatrixKeyRead() {
+	unsigned int mask = 0;
+	unsigned char r, cols;
+	for (r = 0; r < 4; r++) {
+		GPIO_KEY = ~(0x80 >> r);			//第 r 行 (P1.7 ~ P1.4) 拉低，列线保持高电平
+		cols = ~GPIO_KEY & 0x0F;			//按下的列读到 0
+		mask |= (unsigned int)ColBits[cols] << (r * 4);
 	}
-	while((a<20)&&(GPIO_KEY!=0xf0))	 //等待按键松开
-	{
-		Delay(5);
-		a++;
-	}
-    return KeyValue;
-}
\ No newline at end of file
+	GPIO_KEY = 0xFF;
+	return mask;
+}
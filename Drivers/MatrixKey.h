@@ -1,6 +1,6 @@
 #ifndef __MATRIXKEY_H__
 #define __MATRIXKEY_H__
 
-int MatrixKeyDown();
+unsigned int MatrixKeyRead();
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,98 @@
+#include "MCU.h"
+#include "HAL.h"
+#include "Power.h"
+#include "Timer0.h"
+
+//睡眠统计：Timer0 每个节拍检查一次 CPU 是否处于空闲模式 (空闲时正是该中断将其唤醒)，
+//命中的节拍数占总节拍数的比例即睡眠时间占比
+#define POWER_WINDOW_TICKS	((unsigned int)TIMER0_TICKS_PER_S)	//统计窗口 1 秒
+
+static volatile bit Power_Sleeping=0;			//主程序已进入 (或即将进入) 空闲模式
+static unsigned int data Power_Ticks=0;			//本窗口的节拍数
+static unsigned int data Power_SleepTicks=0;	//本窗口中命中空闲的节拍数
+static volatile unsigned int data Power_SleepLast=0;	//上一窗口命中空闲的节拍数
+static unsigned int xdata Power_Downs=0;		//进入掉电模式的次数
+
+/**
+  * @brief  进入空闲模式，任一中断 (Timer0 节拍、按键音、串口) 到来时返回
+  * @param  无
+  * @retval 无
+  */
+void Power_Idle(void)
+{
+	Power_Sleeping=1;
+	HAL_Idle();
+	Power_Sleeping=0;
+}
+
+/**
+  * @brief  进入掉电模式，直到 P3.2/P3.3 上的独立按键按下 (INT0/INT1 下降沿) 才返回
+  *         掉电期间 Timer0 停止，按键扫描、LCD 后台发送与开机毫秒数都暂停
+  * @param  无
+  * @retval 无
+  */
+void Power_Down(void)
+{
+	IT0=1;	//下降沿触发
+	IT1=1;
+	IE0=0;
+	IE1=0;
+	EX0=1;
+	EX1=1;
+	Power_Downs++;
+	HAL_PowerDown();
+	NOP();	//唤醒后先执行中断函数，再从这里继续
+	NOP();
+	EX0=0;
+	EX1=0;
+}
+
+/**
+  * @brief  上一秒处于空闲模式的时间占比
+  * @param  无
+  * @retval 千分比 0~1000
+  */
+unsigned int Power_SleepPermille(void)
+{
+	unsigned int Ticks;
+	ET0=0;
+	Ticks=Power_SleepLast;
+	ET0=1;
+	return (unsigned int)((unsigned long)Ticks*1000/POWER_WINDOW_TICKS);
+}
+
+/**
+  * @brief  开机以来进入掉电模式的次数
+  * @param  无
+  * @retval 次数
+  */
+unsigned int Power_DownCount(void)
+{
+	return Power_Downs;
+}
+
+/**
+  * @brief  睡眠采样，由 Timer0 中断每个节拍调用一次
+  * @param  无
+  * @retval 无
+  */
+void Power_Sample(void)
+{
+	if(Power_Sleeping)Power_SleepTicks++;
+	if(++Power_Ticks>=POWER_WINDOW_TICKS)
+	{
+		Power_SleepLast=Power_SleepTicks;
+		Power_SleepTicks=0;
+		Power_Ticks=0;
+	}
+}
+
+void Int0_Isr(void) INTERRUPT(0)
+{
+	EX0=0;	//只用于唤醒，触发一次即关闭
+}
+
+void Int1_Isr(void) INTERRUPT(2)
+{
+	EX1=0;
+}
@@ -0,0 +1,18 @@
+#ifndef __POWER_H__
+#define __POWER_H__
+
+#include "../Middleware/Compiler.h"
+
+void Power_Idle(void);
+void Power_Down(void);
+unsigned int Power_SleepPermille(void);
+unsigned int Power_DownCount(void);
+
+//仅供 Timer0 中断调用 (每个节拍一次)
+void Power_Sample(void);
+
+// SDCC 要求中断函数原型在 main() 所在文件中可见，否则不会生成中断向量
+void Int0_Isr(void) INTERRUPT(0);
+void Int1_Isr(void) INTERRUPT(2);
+
+#endif
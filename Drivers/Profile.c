@@ -0,0 +1,159 @@
+#include "MCU.h"
+#include "Profile.h"
+
+#if PROFILE
+#include "Timer0.h"
+#include "LCD1602.h"
+#include "Power.h"
+#include "Scheduler.h"
+
+typedef struct {
+	u32 Start;	//本次开始的时间戳
+	u32 Min;
+	u32 Max;
+	u32 Sum;
+	unsigned int Count;
+	unsigned int Hist[PROF_HIST_BINS];
+} ProfStat;
+
+static ProfStat xdata Prof_Stat[PROF_COUNT];
+
+static char code Prof_Name[PROF_COUNT][4] = {
+	"KEY", "CAL", "LEX", "PAR", "D2S", "LCD"
+};
+
+/**
+  * @brief  清空全部统计
+  * @param  无
+  * @retval 无
+  */
+void Prof_Reset()
+{
+	unsigned char i, b;
+	for(i=0;i<PROF_COUNT;i++)
+	{
+		Prof_Stat[i].Min=0xFFFFFFFFUL;
+		Prof_Stat[i].Max=0;
+		Prof_Stat[i].Sum=0;
+		Prof_Stat[i].Count=0;
+		for(b=0;b<PROF_HIST_BINS;b++)Prof_Stat[i].Hist[b]=0;
+	}
+}
+
+/**
+  * @brief  记录一段的开始时间
+  * @param  Id 剖析段编号
+  * @retval 无
+  */
+void Prof_Begin(unsigned char Id)
+{
+	Prof_Stat[Id].Start=Timer0_Cycles();
+}
+
+/**
+  * @brief  记录一段的结束时间，更新最小/最大/累计与直方图
+  * @param  Id 剖析段编号
+  * @retval 无
+  */
+void Prof_End(unsigned char Id)
+{
+	u32 d=Timer0_Cycles();
+	ProfStat xdata *s=&Prof_Stat[Id];
+	unsigned char b;
+
+	d-=s->Start;
+	if(s->Count==0xFFFF)return;	//计数已满，保持现有统计
+	s->Count++;
+	s->Sum+=d;
+	if(d<s->Min)s->Min=d;
+	if(d>s->Max)s->Max=d;
+	for(b=0,d>>=8;d&&b<PROF_HIST_BINS-1;b++)d>>=2;
+	s->Hist[b]++;
+}
+
+/**
+  * @brief  无符号整数转十进制字符串，返回写入的字符数
+  */
+static unsigned char Prof_Utoa(unsigned long v,char *buf)
+{
+	char tmp[10];
+	unsigned char n=0,i=0;
+	do
+	{
+		tmp[n++]=(char)(v%10)+'0';
+		v/=10;
+	} while(v);
+	while(n)buf[i++]=tmp[--n];
+	buf[i]='\0';
+	return i;
+}
+
+/**
+  * @brief  在液晶上显示一页统计 (每段两页：次数与最小/平均/最大周期数、直方图，最后一页为睡眠占比)
+  * @param  Page 页码，从 0 开始
+  * @retval 1 已显示，0 页码超出范围
+  */
+unsigned char Prof_Show(unsigned char Page)
+{
+	char xdata buf[17];
+	ProfStat xdata *s;
+	unsigned char i,n;
+	unsigned int top;
+
+	if(Page>=PROF_COUNT*2)
+	{
+		if(Page>PROF_COUNT*2)return 0;
+		//系统页：上一秒睡眠千分比与空闲次数
+		LCD_ShowLine(1,"SYS sleep/1000");
+		n=Prof_Utoa(Power_SleepPermille(),buf);
+		buf[n++]=' ';
+		n+=Prof_Utoa(Sched_IdleCount(),buf+n);
+		LCD_ShowLine(2,buf);
+		return 1;
+	}
+
+	s=&Prof_Stat[Page>>1];
+	for(i=0;i<3;i++)buf[i]=Prof_Name[Page>>1][i];
+	buf[3]=' ';
+	if(!(Page&1))
+	{
+		//第 1 行：名称 n=次数；第 2 行：最小 平均 最大
+		buf[4]='n';
+		buf[5]='=';
+		Prof_Utoa(s->Count,buf+6);
+		LCD_ShowLine(1,buf);
+		if(s->Count==0)
+		{
+			LCD_ShowLine(2,"-");
+			return 1;
+		}
+		n=Prof_Utoa(s->Min,buf);
+		buf[n++]=' ';
+		n+=Prof_Utoa(s->Sum/s->Count,buf+n);
+		buf[n++]=' ';
+		if(n<16)Prof_Utoa(s->Max,buf+n);
+		buf[16]='\0';
+		LCD_ShowLine(2,buf);
+	}
+	else
+	{
+		//第 2 行：各档次数按最大档缩放为 0~9
+		buf[4]='h';
+		buf[5]='i';
+		buf[6]='s';
+		buf[7]='t';
+		buf[8]='\0';
+		LCD_ShowLine(1,buf);
+		top=1;
+		for(i=0;i<PROF_HIST_BINS;i++)if(s->Hist[i]>top)top=s->Hist[i];
+		for(i=0;i<PROF_HIST_BINS;i++)
+		{
+			buf[i]=s->Hist[i]?(char)('1'+(unsigned long)(s->Hist[i]-1)*9/top):'.';
+			if(buf[i]>'9')buf[i]='9';
+		}
+		buf[i]='\0';
+		LCD_ShowLine(2,buf);
+	}
+	return 1;
+}
+#endif
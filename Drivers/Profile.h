@@ -0,0 +1,34 @@
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+//性能剖析开关：1 记录各段耗时 (机器周期)，0 时下列宏全部展开为空，不占代码与内存
+//可在编译命令中覆盖，例如 -DPROFILE=1
+#ifndef PROFILE
+#define PROFILE	0
+#endif
+
+//剖析段编号
+#define PROF_KEY	0	//按键从取出事件到最后一个字节写入液晶
+#define PROF_CALC	1	//一次按键的完整处理 (OnKeyPress)
+#define PROF_LEXER	2	//Lexer_ProcessChar / Lexer_ToString (输入预览)
+#define PROF_PARSER	3	//Calc_PushNum / Calc_PushOp / Calc_GetResult
+#define PROF_D2S	4	//Num_ToString (浮点后端即 Double2String)
+#define PROF_LCD	5	//LCD_Flush (只含主程序的入队，不含中断发送)
+#define PROF_COUNT	6
+
+#define PROF_HIST_BINS	8	//直方图按 4 的幂分档：<256、<1K、<4K ... >=1M 个机器周期
+
+#if PROFILE
+#define PROF_BEGIN(id)	Prof_Begin(id)
+#define PROF_END(id)	Prof_End(id)
+
+void Prof_Begin(unsigned char Id);
+void Prof_End(unsigned char Id);
+void Prof_Reset();
+unsigned char Prof_Show(unsigned char Page);
+#else
+#define PROF_BEGIN(id)
+#define PROF_END(id)
+#endif
+
+#endif
@@ -0,0 +1,88 @@
+#include "MCU.h"
+#include "Scheduler.h"
+#include "Timer0.h"
+
+//空闲统计：主循环一轮没有任务做事时调用 Sched_Idle 计数，每 SCHED_STAT_MS 锁存一次
+static u16 xdata Sched_Loops=0;	//本周期的空闲次数
+static u16 xdata Sched_Last=0;	//上一周期的空闲次数
+static u16 xdata Sched_Max=0;		//出现过的最大空闲次数 (近似于完全空闲时的值)
+static SoftTimer xdata Sched_StatTimer;
+
+/**
+  * @brief  启动软件定时器
+  * @param  Timer 定时器
+  * @param  Ms 定时时长 (毫秒)
+  * @retval 无
+  */
+void SoftTimer_Start(SoftTimer *Timer,u16 Ms)
+{
+	Timer->Start=Timer0_Millis16();
+	Timer->Ms=Ms;
+}
+
+/**
+  * @brief  查询软件定时器是否到期 (按无符号的经过时间判断，计数回绕不影响结果)
+  *         到期后把时长清零锁存，之后无论再过多久都保持已到期；
+  *         须在启动后 65 秒内至少查询一次
+  * @param  Timer 定时器
+  * @retval 1 已到期，0 未到期
+  */
+unsigned char SoftTimer_Expired(SoftTimer *Timer)
+{
+	if((u16)(Timer0_Millis16()-Timer->Start)<Timer->Ms)return 0;
+	Timer->Ms=0;
+	return 1;
+}
+
+/**
+  * @brief  周期任务调度：距上次运行满一个周期时返回 1，并把上次运行时刻顺延一个周期 (不累积误差)
+  *         按无符号的经过时间判断，任务长时间不调用 (如显示无改动、掉电唤醒) 后第一次调用即运行，
+  *         最坏只在经过时间超过 65 秒回绕时多等一个周期
+  * @param  Timer 该任务的定时器
+  * @param  Period 周期 (毫秒)
+  * @retval 1 本轮应运行，0 未到时间
+  */
+unsigned char Sched_Every(SoftTimer *Timer,u16 Period)
+{
+	u16 Now=Timer0_Millis16();
+	if((u16)(Now-Timer->Start)<Period)return 0;
+	Timer->Start+=Period;
+	if((u16)(Now-Timer->Start)>=Period)Timer->Start=Now;	//落后超过一个周期，不补跑
+	return 1;
+}
+
+/**
+  * @brief  主循环空闲一轮时调用，统计空闲次数
+  * @param  无
+  * @retval 无
+  */
+void Sched_Idle(void)
+{
+	if(Sched_Loops!=0xFFFF)Sched_Loops++;
+	if(Sched_Every(&Sched_StatTimer,SCHED_STAT_MS))
+	{
+		Sched_Last=Sched_Loops;
+		if(Sched_Last>Sched_Max)Sched_Max=Sched_Last;
+		Sched_Loops=0;
+	}
+}
+
+/**
+  * @brief  上一统计周期的空闲次数，与 Sched_IdleMax() 之比即空闲率
+  * @param  无
+  * @retval 空闲次数
+  */
+u16 Sched_IdleCount(void)
+{
+	return Sched_Last;
+}
+
+/**
+  * @brief  出现过的最大空闲次数
+  * @param  无
+  * @retval 空闲次数
+  */
+u16 Sched_IdleMax(void)
+{
+	return Sched_Max;
+}
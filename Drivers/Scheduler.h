@@ -0,0 +1,23 @@
+#ifndef __SCHEDULER_H__
+#define __SCHEDULER_H__
+
+#include "MCU.h"
+
+//软件定时器：保存起始时刻 (毫秒计数低 16 位) 与时长，按经过的时间判断，最长定时约 65 秒
+//单次定时到期后锁存为已到期；周期任务 (Sched_Every) 只用 Start 记录上次运行的时刻
+typedef struct {
+	u16 Start;
+	u16 Ms;
+} SoftTimer;
+
+#define SCHED_STAT_MS	1000	//空闲计数统计周期
+
+void SoftTimer_Start(SoftTimer *Timer,u16 Ms);
+unsigned char SoftTimer_Expired(SoftTimer *Timer);
+unsigned char Sched_Every(SoftTimer *Timer,u16 Period);
+
+void Sched_Idle(void);
+u16 Sched_IdleCount(void);
+u16 Sched_IdleMax(void);
+
+#endif
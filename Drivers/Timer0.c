@@ -0,0 +1,98 @@
+#include "MCU.h"
+#include "Timer0.h"
+#include "LCD1602.h"
+#include "KeyScan.h"
+#include "Buzzer.h"
+#include "Power.h"
+#include "Profile.h"
+
+static unsigned int data Timer0_MsCycles=0;	//本毫秒内已过的机器周期数
+static volatile u32 data Timer0_Ms=0;	//开机以来的毫秒数
+#if PROFILE
+static volatile u32 data Timer0_Ticks=0;	//节拍计数，与 TL0 组合为机器周期时间戳 (32 位，乘积按 2^32 回绕，求差不受影响)
+#endif
+
+void Timer0_Init(void)		//TIMER0_TICK_CYCLES 个机器周期，16位模式，中断中重装高字节
+{
+	TMOD &= 0xF0;			//清除定时器0模式位
+	TMOD |= 0x01;			//设置定时器0为16位模式
+	TL0 = 0;				//设置定时初值
+	TH0 = TIMER0_RELOAD_H;
+	TF0 = 0;				//清除TF0标志
+	TR0 = 1;				//定时器0开始计时
+	ET0 = 1;				//使能定时器0中断
+	EA = 1;
+	PT0 = 0;
+}
+
+void Timer0_Isr(void) INTERRUPT(1)
+{
+	TH0 = TIMER0_RELOAD_H;	//TL0 溢出后从 0 继续计数，只需重装高字节
+#if PROFILE
+	Timer0_Ticks++;
+#endif
+	Power_Sample();
+#if LCD_ASYNC
+	LCD_Service();
+#endif
+	Timer0_MsCycles += TIMER0_TICK_CYCLES;
+	if (Timer0_MsCycles >= TIMER0_MS_CYCLES)	//毫秒节拍
+	{
+		Timer0_MsCycles -= TIMER0_MS_CYCLES;
+		Timer0_Ms++;
+		Key_Scan();
+		Buzzer_Service();
+	}
+}
+
+/**
+ * @brief  读取开机以来的毫秒数 (关中断读取，保证多字节一致)
+ * @param  无
+ * @return 毫秒数，约 49.7 天回绕
+ */
+u32 Timer0_Millis(void)
+{
+	u32 Ms;
+	ET0 = 0;
+	Ms = Timer0_Ms;
+	ET0 = 1;
+	return Ms;
+}
+
+/**
+ * @brief  读取毫秒计数的低 16 位，用于软件定时器 (比 32 位读取更快)
+ * @param  无
+ * @return 毫秒数低 16 位
+ */
+u16 Timer0_Millis16(void)
+{
+	u16 Ms;
+	ET0 = 0;
+	Ms = (u16)Timer0_Ms;
+	ET0 = 1;
+	return Ms;
+}
+
+#if PROFILE
+/**
+ * @brief  机器周期时间戳：节拍数 * 每节拍周期数 + 本节拍已计数值 (按 2^32 回绕，只用于求差)
+ *         节拍计数为 32 位，积的回绕与时间戳本身一致；若只用 16 位节拍计数，65536 个节拍处的
+ *         回绕不是 2^32 的整数倍，跨越该点的求差会得到约 42 亿的错误值
+ *         读取期间若发生节拍中断则重读，保证两部分一致
+ * @param  无
+ * @return 机器周期数
+ */
+u32 Timer0_Cycles(void)
+{
+	u32 Ticks;
+	unsigned char High, Low;
+	do
+	{
+		Ticks = Timer0_Ticks;
+		High = TH0;
+		Low = TL0;
+	} while (Ticks != Timer0_Ticks || High != TH0);
+	//溢出后中断尚未重装时 TH0 为 0，差值正好多出一个节拍，与尚未计入的节拍数相符
+	return Ticks * TIMER0_TICK_CYCLES + ((unsigned int)(unsigned char)(High - TIMER0_RELOAD_H) << 8) + Low;
+}
+#endif
@@ -0,0 +1,39 @@
+#ifndef __TIMER0_H__
+#define __TIMER0_H__
+
+#include "MCU.h"
+
+//节拍：定时器0 工作在 16 位模式 1，每节拍为 256 个机器周期的整数倍 (约 250 微秒，时钟越快每节拍的周期数越多，
+//节拍率不随时钟升高)。溢出后 TL0 从 0 继续计数，中断里只重装 TH0，只要在 TL0 再次溢出 (256 个机器周期) 前写入，
+//中断延迟不影响节拍长度，不累积误差
+#define TIMER0_TICK_PAGES	(((MCU_US_TO_CYCLES(250)+128)/256) ? ((MCU_US_TO_CYCLES(250)+128)/256) : 1)
+#define TIMER0_TICK_CYCLES	(TIMER0_TICK_PAGES*256UL)	//每节拍的机器周期数
+#define TIMER0_RELOAD_H	(256-TIMER0_TICK_PAGES)	//TH0 重装值
+#define TIMER0_TICK_US	(TIMER0_TICK_CYCLES*1000000UL/MCU_CYCLE_HZ)	//节拍周期 (微秒，向下取整)
+#define TIMER0_TICKS_PER_S	(MCU_CYCLE_HZ/TIMER0_TICK_CYCLES)	//每秒节拍数 (向下取整)
+//毫秒分频：中断中累加每节拍的机器周期数，满一毫秒推进毫秒计数，按键扫描与蜂鸣器按毫秒推进
+//(节拍不足一毫秒，每个节拍至多推进一毫秒)
+#define TIMER0_MS_CYCLES	(MCU_CYCLE_HZ/1000)
+
+/**
+ * @brief  初始化定时器0 (周期节拍中断)
+ * @param  无
+ * @return 无
+ */
+void Timer0_Init(void);
+
+/**
+ * @brief  开机以来的毫秒数 (Timer0 中断计数)
+ * @param  无
+ * @return 毫秒数
+ */
+u32 Timer0_Millis(void);
+u16 Timer0_Millis16(void);
+
+//机器周期时间戳，仅在 PROFILE 打开时提供 (见 Profile.h)
+u32 Timer0_Cycles(void);
+
+// SDCC 要求中断函数原型在 main() 所在文件中可见，否则不会生成中断向量
+void Timer0_Isr(void) INTERRUPT(1);
+
+#endif
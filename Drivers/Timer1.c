@@ -1,23 +0,0 @@
-#include <regx52.h>
-#include "Timer1.h"
-
-/*	Timer1 templet
-void Timer1_Isr(void) interrupt 3
-{
-	TL1 = 0x18;				//???????
-	TH1 = 0xFC;				//???????
-}
-*/
-
-void Timer1_Init(void)		//1??@12.000MHz
-{
-	TMOD &= 0x0F;			//???????
-	TMOD |= 0x10;			//???????
-	TL1 = 0x18;				//???????
-	TH1 = 0xFC;				//???????
-	TF1 = 0;				//??TF1??
-	TR1 = 1;				//???1????
-	ET1 = 1;				//?????1??
-	EA = 1;
-	PT1 = 0;
-}
\ No newline at end of file
@@ -1,12 +0,0 @@
-#ifndef __TIMER1_H__
-#define __TIMER1_H__
-
-/**
- * @brief  初始化定时器1
- * @param  无
- * @return 无
- */
-
-void Timer1_Init(void);
-
-#endif
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "MCU.h"
+#include "HAL.h"
+#include "Uart.h"
+
+#if UART_STREAM
+
+//SMOD=1 时波特率 = MCU_CYCLE_HZ / 16 / (256 - TH1)，四舍五入
+#define UART_TH1	(256 - (MCU_CYCLE_HZ / 16 + UART_BAUD / 2) / UART_BAUD)
+#define UART_ACTUAL	(MCU_CYCLE_HZ / 16 / (256 - UART_TH1))
+#if UART_ACTUAL * 100 > UART_BAUD * 102 || UART_ACTUAL * 100 < UART_BAUD * 98
+#error "UART_BAUD cannot be generated within 2% from this FOSC"
+#endif
+
+//收发队列 (必须为 2 的幂)：接收队列较大，留出主机收到 XOFF 之前仍会发来的字节
+#define UART_RX_SIZE	64
+#define UART_TX_SIZE	32
+#define UART_RX_HIGH	48	//队列中的字节数达到该值时发送 XOFF (剩余 16 字节余量，覆盖主机 UART 的 FIFO)
+#define UART_RX_LOW		16	//取走到该值以下时发送 XON
+
+static unsigned char xdata Uart_RxBuf[UART_RX_SIZE];
+static unsigned char xdata Uart_TxBuf[UART_TX_SIZE];
+static volatile unsigned char data Uart_RxHead=0;	//中断写入位置
+static volatile unsigned char data Uart_RxTail=0;	//主程序读取位置
+static volatile unsigned char data Uart_TxHead=0;	//主程序写入位置
+static volatile unsigned char data Uart_TxTail=0;	//中断读取位置
+static volatile unsigned char data Uart_Flow=0;		//待发送的流控字符 (优先于队列，0 表示无)
+static volatile bit Uart_TxBusy=0;	//SBUF 正在发送，发送完成中断会接着发下一个
+static volatile bit Uart_Stopped=0;	//已发送 XOFF
+static unsigned int xdata Uart_Lost=0;	//接收队列满而丢弃的字节数
+
+/**
+  * @brief  串口初始化：模式 1 (8N1)，Timer1 作波特率发生器，打开串口中断
+  * @param  无
+  * @retval 无
+  */
+void Uart_Init(void)
+{
+	SCON=0x50;		//模式 1，允许接收
+	PCON|=0x80;		//SMOD=1，波特率加倍
+	TMOD&=0x0F;
+	TMOD|=0x20;		//Timer1: 8 位自动重装
+	TH1=UART_TH1;
+	TL1=UART_TH1;
+	ET1=0;			//Timer1 只作波特率发生器，不产生中断
+	TR1=1;
+	TI=0;
+	RI=0;
+	PS=0;			//低优先级：蜂鸣器的 Timer2 翻转中断优先
+	ES=1;
+	EA=1;
+}
+
+/**
+  * @brief  取一个收到的字节，队列回落到低水位时发送 XON
+  * @param  无
+  * @retval 字节 (0~255)，队列为空时返回 -1
+  */
+int Uart_GetChar(void)
+{
+	unsigned char c;
+
+	if(Uart_RxHead==Uart_RxTail)return -1;
+	c=Uart_RxBuf[Uart_RxTail];
+	Uart_RxTail=(Uart_RxTail+1)&(UART_RX_SIZE-1);
+	if(Uart_Stopped && ((Uart_RxHead-Uart_RxTail)&(UART_RX_SIZE-1))<=UART_RX_LOW)
+	{
+		ES=0;
+		Uart_Stopped=0;
+		Uart_Flow=UART_XON;
+		if(!Uart_TxBusy)TI=1;	//发送空闲时软件置 TI，由中断发出
+		ES=1;
+	}
+	return c;
+}
+
+/**
+  * @brief  发送一个字节 (放入发送队列，队列满时等待中断腾出空间)
+  * @param  c 要发送的字节
+  * @retval 无
+  */
+void Uart_PutChar(char c)
+{
+	unsigned char next=(Uart_TxHead+1)&(UART_TX_SIZE-1);
+	while(next==Uart_TxTail)HAL_Poll();
+	Uart_TxBuf[Uart_TxHead]=c;
+	ES=0;
+	Uart_TxHead=next;
+	if(!Uart_TxBusy)TI=1;
+	ES=1;
+}
+
+/**
+  * @brief  发送字符串
+  * @param  s 以 '\0' 结尾的字符串
+  * @retval 无
+  */
+void Uart_PutString(char *s)
+{
+	while(*s)Uart_PutChar(*s++);
+}
+
+/**
+  * @brief  等待发送队列与 SBUF 全部发送完毕
+  * @param  无
+  * @retval 无
+  */
+void Uart_Flush(void)
+{
+	while(Uart_TxHead!=Uart_TxTail || Uart_TxBusy)HAL_Poll();
+}
+
+/**
+  * @brief  接收队列满而丢弃的字节数 (主机未响应 XOFF 时出现)
+  * @param  无
+  * @retval 字节数
+  */
+unsigned int Uart_LostCount(void)
+{
+	unsigned int n;
+	ES=0;
+	n=Uart_Lost;
+	ES=1;
+	return n;
+}
+
+void Uart_Isr(void) INTERRUPT(4)
+{
+	unsigned char c,next;
+
+	if(RI)
+	{
+		RI=0;
+		c=SBUF;
+		next=(Uart_RxHead+1)&(UART_RX_SIZE-1);
+		if(next!=Uart_RxTail)
+		{
+			Uart_RxBuf[Uart_RxHead]=c;
+			Uart_RxHead=next;
+		}
+		else
+		{
+			Uart_Lost++;
+		}
+		if(!Uart_Stopped && ((Uart_RxHead-Uart_RxTail)&(UART_RX_SIZE-1))>=UART_RX_HIGH)
+		{
+			Uart_Stopped=1;
+			Uart_Flow=UART_XOFF;
+			if(!Uart_TxBusy)TI=1;	//发送空闲，由下面的发送分支立即发出
+		}
+	}
+	if(TI)
+	{
+		TI=0;
+		if(Uart_Flow)
+		{
+			SBUF=Uart_Flow;
+			Uart_Flow=0;
+			Uart_TxBusy=1;
+		}
+		else if(Uart_TxHead!=Uart_TxTail)
+		{
+			SBUF=Uart_TxBuf[Uart_TxTail];
+			Uart_TxTail=(Uart_TxTail+1)&(UART_TX_SIZE-1);
+			Uart_TxBusy=1;
+		}
+		else
+		{
+			Uart_TxBusy=0;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef __UART_H__
+#define __UART_H__
+
+#include "../Middleware/Compiler.h"
+
+//串口协处理模式：1 打开，P3.0/P3.1 作为 RXD/TXD，接在上面的两个独立按键 ('(' 与 ')') 不再读取
+//0 关闭 (默认)，本驱动不参与编译
+#ifndef UART_STREAM
+#define UART_STREAM	0
+#endif
+
+//波特率：SMOD=1，Timer1 8 位自动重装，重装值由 MCU_CYCLE_HZ 推导 (12MHz/12T 时 4800bps 误差 0.16%)
+#ifndef UART_BAUD
+#define UART_BAUD	4800UL
+#endif
+
+//软件流控 (XON/XOFF)：接收队列将满时发送 XOFF，取走到低水位后发送 XON，主机须打开 XON/XOFF 流控
+#define UART_XON	0x11
+#define UART_XOFF	0x13
+
+#if UART_STREAM
+void Uart_Init(void);
+int Uart_GetChar(void);
+void Uart_PutChar(char c);
+void Uart_PutString(char *s);
+void Uart_Flush(void);
+unsigned int Uart_LostCount(void);
+
+// SDCC 要求中断函数原型在 main() 所在文件中可见，否则不会生成中断向量
+void Uart_Isr(void) INTERRUPT(4);
+#endif
+
+#endif
@@ -0,0 +1,375 @@
+/**
+ * @file    BatchEval.c
+ * @author  严嘉哲
+ * @brief   主机批量求值工具 (Linux)：逐行读入算式，多线程求值，按输入顺序输出结果
+ *          与固件共用 Lexer/Parser/数值后端/格式化代码，结果与液晶第二行显示的内容逐字节一致
+ * @version 1.0
+ * @date    2026-10-16
+ *
+ * 用法: calc_batch [-j 线程数] [-q] [文件]
+ *   每行一条算式 (如 "12*(3+4)")，末尾的 '=' 可省略；每行输出结果 (如 "84") 或错误信息 (如 "Syntax Error")
+ *   给出文件时内存映射读取，不给或为 "-" 时从标准输入流式读取
+ *   -j 工作线程数 (默认为在线 CPU 数)，-q 不输出结果，只统计
+ *   吞吐量 (条/秒) 与单条延迟分位数输出到标准错误
+ *
+ * 流水线: 输入按批切行，两批交替使用，工作线程求值一批的同时，主线程输出上一批并读入下一批
+ */
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "../Middleware/Common.h"
+#include "../Middleware/Lexer.h"
+#include "../Middleware/Parser.h"
+#include "../Middleware/Num.h"
+#include "../Middleware/Stream.h"
+
+#define BATCH_LINES   65536         // 每批行数
+#define CHUNK_LINES   256           // 工作线程每次领取的行数
+#define READ_BYTES    (1 << 20)     // 标准输入每次读取的字节数
+#define OUT_LEN       20            // 单行结果的最大长度 (含结束符)，最长的错误信息 "Divided By Zero" 为 15 字符
+#define MAX_WORKERS   256
+
+STATIC_ASSERT(STREAM_OUT_LEN <= OUT_LEN, result_fits_out_slot);
+
+// 延迟直方图: 对数-线性分桶，每个 2 的幂区间再分 16 档 (相对误差不超过 6%)
+#define LAT_SUB_BITS  4
+#define LAT_BUCKETS   (64 << LAT_SUB_BITS)
+
+// ============================================================
+// 1. 数据结构
+// ============================================================
+
+typedef struct {
+    size_t off;                     // 行首在本批数据中的偏移
+    uint32_t len;                   // 行长 (不含换行符)
+} Line;
+
+typedef struct {
+    const char *base;               // 本批数据起点 (内存映射的文件，或 buf)
+    char *buf;                      // 标准输入模式下本批的数据缓冲
+    size_t buf_len, buf_cap;
+    Line line[BATCH_LINES];
+    char out[BATCH_LINES][OUT_LEN];
+    uint32_t n;
+} Batch;
+
+typedef struct {
+    pthread_t tid;
+    LexerCtx lexer;                 // 每个线程独立的计算器上下文
+    CalcCtx calc;
+    StreamCtx stream;               // 在上面两个上下文上逐字符求值
+    uint64_t hist[LAT_BUCKETS];
+} Worker;
+
+// 输入源
+static int from_file;               // 1: 读内存映射的文件，0: 读标准输入
+static const char *map_base;
+static size_t map_len, map_pos;
+static const char *carry;           // 标准输入: 上一批末尾不完整的一行
+static size_t carry_len;
+static int in_eof;
+
+// 线程间共享 (由两道栅栏同步)
+static Batch *batch[2];
+static Batch *volatile work;
+static uint32_t work_next;          // 下一个待领取的行号 (原子加)
+static volatile int work_stop;
+static pthread_barrier_t bar_start, bar_done;
+
+// ============================================================
+// 2. 求值
+// ============================================================
+
+/**
+ * @brief  求值一行算式，与串口协处理模式同样经 StreamCtx 逐字符处理；结果写入 out
+ * @param  w   工作线程 (提供上下文)
+ * @param  s   算式
+ * @param  n   算式长度
+ * @param  out 输出: Num_ToString 的结果或错误信息
+ */
+static void eval_line(Worker *w, const char *s, uint32_t n, char *out) {
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        if (StreamCtx_Feed(&w->stream, s[i], out)) break;  // 已有结果 ('=' 或出错)，其余字符忽略
+    }
+    StreamCtx_Feed(&w->stream, '\n', out);              // 行尾: 没有 '=' 时在此给出结果，并开始下一行
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static unsigned lat_bucket(uint64_t ns) {
+    unsigned msb;
+
+    if (ns < (1u << LAT_SUB_BITS)) return (unsigned)ns;
+    msb = 63 - (unsigned)__builtin_clzll(ns);
+    return ((msb - LAT_SUB_BITS + 1) << LAT_SUB_BITS)
+         + (unsigned)((ns >> (msb - LAT_SUB_BITS)) & ((1u << LAT_SUB_BITS) - 1));
+}
+
+/**
+ * @brief  分桶的下界 (纳秒)
+ */
+static uint64_t lat_bucket_ns(unsigned b) {
+    unsigned e;
+
+    if (b < (1u << LAT_SUB_BITS)) return b;
+    e = (b >> LAT_SUB_BITS) - 1;
+    return (uint64_t)((1u << LAT_SUB_BITS) | (b & ((1u << LAT_SUB_BITS) - 1))) << e;
+}
+
+/**
+ * @brief  工作线程: 每批按 CHUNK_LINES 行领取，直到本批领完
+ *         每行只读一次时钟，单行延迟为与上一行结束时刻之差
+ */
+static void *worker_main(void *arg) {
+    Worker *w = (Worker *)arg;
+    Batch *b;
+    uint32_t i, end;
+    uint64_t t0, t1;
+
+    for (;;) {
+        pthread_barrier_wait(&bar_start);
+        if (work_stop) break;
+        b = work;
+        while ((i = __atomic_fetch_add(&work_next, CHUNK_LINES, __ATOMIC_RELAXED)) < b->n) {
+            end = (b->n - i < CHUNK_LINES) ? b->n : i + CHUNK_LINES;
+            t0 = now_ns();
+            for (; i < end; i++) {
+                eval_line(w, b->base + b->line[i].off, b->line[i].len, b->out[i]);
+                t1 = now_ns();
+                w->hist[lat_bucket(t1 - t0)]++;
+                t0 = t1;
+            }
+        }
+        pthread_barrier_wait(&bar_done);
+    }
+    return NULL;
+}
+
+// ============================================================
+// 3. 输入与输出
+// ============================================================
+
+static void die(const char *msg) {
+    perror(msg);
+    exit(1);
+}
+
+static void *xmalloc(size_t n) {
+    void *p = malloc(n);
+    if (!p) die("malloc");
+    return p;
+}
+
+/**
+ * @brief  从 p[0..len) 中切出完整的行追加到本批，直到批满
+ * @return size_t 已消耗的字节数 (其后为不完整的行或未处理的行)
+ */
+static size_t split_lines(Batch *b, size_t base_off, const char *p, size_t len) {
+    const char *nl;
+    size_t pos = 0;
+
+    while (b->n < BATCH_LINES && (nl = memchr(p + pos, '\n', len - pos)) != NULL) {
+        b->line[b->n].off = base_off + pos;
+        b->line[b->n].len = (uint32_t)(nl - (p + pos));
+        b->n++;
+        pos = (size_t)(nl - p) + 1;
+    }
+    return pos;
+}
+
+/**
+ * @brief  读入下一批 (内存映射模式只切行，不复制)
+ */
+static void fill_batch(Batch *b) {
+    size_t used;
+    ssize_t got;
+
+    b->n = 0;
+    if (from_file) {
+        b->base = map_base;
+        map_pos += split_lines(b, map_pos, map_base + map_pos, map_len - map_pos);
+        if (b->n < BATCH_LINES && map_pos < map_len) {      // 最后一行没有换行符
+            b->line[b->n].off = map_pos;
+            b->line[b->n].len = (uint32_t)(map_len - map_pos);
+            b->n++;
+            map_pos = map_len;
+        }
+        return;
+    }
+
+    // 标准输入: 先放入上一批剩下的半行，再按块读取
+    // (carry 指向另一批的缓冲区，那一批此时正被工作线程只读访问)
+    b->buf_len = 0;
+    if (carry_len > b->buf_cap) {
+        b->buf_cap = carry_len + READ_BYTES;
+        free(b->buf);
+        b->buf = xmalloc(b->buf_cap);
+    }
+    if (carry_len) memcpy(b->buf, carry, carry_len);
+    b->buf_len = carry_len;
+    used = 0;
+    for (;;) {
+        used += split_lines(b, used, b->buf + used, b->buf_len - used);
+        if (b->n == BATCH_LINES || in_eof) break;
+        if (b->buf_cap - b->buf_len < READ_BYTES) {
+            b->buf_cap = b->buf_cap * 2 + READ_BYTES;
+            b->buf = realloc(b->buf, b->buf_cap);
+            if (!b->buf) die("realloc");
+        }
+        got = read(STDIN_FILENO, b->buf + b->buf_len, READ_BYTES);
+        if (got < 0) die("read");
+        if (got == 0) in_eof = 1;
+        b->buf_len += (size_t)got;
+    }
+    if (in_eof && b->n < BATCH_LINES && used < b->buf_len) {    // 最后一行没有换行符
+        b->line[b->n].off = used;
+        b->line[b->n].len = (uint32_t)(b->buf_len - used);
+        b->n++;
+        used = b->buf_len;
+    }
+    b->base = b->buf;
+    carry = b->buf + used;
+    carry_len = b->buf_len - used;
+}
+
+static void write_batch(const Batch *b) {
+    uint32_t i;
+    for (i = 0; i < b->n; i++) {
+        fputs_unlocked(b->out[i], stdout);
+        putc_unlocked('\n', stdout);
+    }
+}
+
+// ============================================================
+// 4. 主程序
+// ============================================================
+
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-j threads] [-q] [file|-]\n", prog);
+    exit(2);
+}
+
+/**
+ * @brief  输出吞吐量与延迟分位数 (合并各线程的直方图)
+ */
+static void report(Worker *w, int nw, uint64_t count, uint64_t elapsed_ns) {
+    static uint64_t hist[LAT_BUCKETS];
+    static const unsigned permille[] = { 500, 900, 990, 999 };
+    static const char *name[] = { "p50", "p90", "p99", "p99.9" };
+    uint64_t seen, target, max_b = 0;
+    unsigned b, k;
+    int i;
+
+    for (i = 0; i < nw; i++) {
+        for (b = 0; b < LAT_BUCKETS; b++) hist[b] += w[i].hist[b];
+    }
+    fprintf(stderr, "calc_batch: %llu expr, %d threads, num=%s, %.3f s, %.0f expr/s\n",
+            (unsigned long long)count, nw, NUM_NAME, (double)elapsed_ns / 1e9,
+            elapsed_ns ? (double)count * 1e9 / (double)elapsed_ns : 0.0);
+    if (!count) return;
+
+    fprintf(stderr, "latency (ns):");
+    for (k = 0; k < sizeof(permille) / sizeof(permille[0]); k++) {
+        target = (count * permille[k] + 999) / 1000;
+        for (seen = 0, b = 0; b < LAT_BUCKETS; b++) {
+            seen += hist[b];
+            if (seen >= target) break;
+        }
+        fprintf(stderr, " %s=%llu", name[k], (unsigned long long)lat_bucket_ns(b));
+    }
+    for (b = 0; b < LAT_BUCKETS; b++) {
+        if (hist[b]) max_b = b;
+    }
+    fprintf(stderr, " max=%llu\n", (unsigned long long)lat_bucket_ns((unsigned)max_b));
+}
+
+int main(int argc, char **argv) {
+    static Worker workers[MAX_WORKERS];
+    static char out_buf[1 << 20];
+    Batch *cur, *next, *prev = NULL;
+    const char *path = NULL;
+    struct stat st;
+    uint64_t count = 0, t_begin;
+    int nw, opt, quiet = 0, fd, i;
+
+    nw = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    while ((opt = getopt(argc, argv, "j:q")) != -1) {
+        switch (opt) {
+            case 'j': nw = atoi(optarg); break;
+            case 'q': quiet = 1; break;
+            default:  usage(argv[0]);
+        }
+    }
+    if (optind + 1 < argc) usage(argv[0]);
+    if (optind < argc && strcmp(argv[optind], "-") != 0) path = argv[optind];
+    if (nw < 1) nw = 1;
+    if (nw > MAX_WORKERS) nw = MAX_WORKERS;
+
+    if (path) {
+        from_file = 1;
+        fd = open(path, O_RDONLY);
+        if (fd < 0 || fstat(fd, &st) < 0) die(path);
+        map_len = (size_t)st.st_size;
+        if (map_len) {
+            map_base = mmap(NULL, map_len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map_base == MAP_FAILED) die("mmap");
+            madvise((void *)map_base, map_len, MADV_SEQUENTIAL);
+        }
+        close(fd);
+    }
+    setvbuf(stdout, out_buf, _IOFBF, sizeof(out_buf));
+
+    batch[0] = xmalloc(sizeof(Batch));
+    batch[1] = xmalloc(sizeof(Batch));
+    memset(batch[0], 0, sizeof(Batch));
+    memset(batch[1], 0, sizeof(Batch));
+
+    pthread_barrier_init(&bar_start, NULL, (unsigned)nw + 1);
+    pthread_barrier_init(&bar_done, NULL, (unsigned)nw + 1);
+    for (i = 0; i < nw; i++) {
+        StreamCtx_Init(&workers[i].stream, &workers[i].lexer, &workers[i].calc);
+        if (pthread_create(&workers[i].tid, NULL, worker_main, &workers[i]) != 0) die("pthread_create");
+    }
+
+    t_begin = now_ns();
+    cur = batch[0];
+    fill_batch(cur);
+    for (;;) {
+        next = (cur == batch[0]) ? batch[1] : batch[0];
+        if (cur->n) {                               // 工作线程开始求值本批
+            work = cur;
+            work_next = 0;
+            pthread_barrier_wait(&bar_start);
+        }
+        if (prev && !quiet) write_batch(prev);      // 同时输出上一批 (prev 与 next 是同一块)
+        if (!cur->n) break;
+        fill_batch(next);                           // 再把它的缓冲区用来读下一批
+        pthread_barrier_wait(&bar_done);
+        count += cur->n;
+        prev = cur;
+        cur = next;
+    }
+    fflush(stdout);
+
+    work_stop = 1;
+    pthread_barrier_wait(&bar_start);
+    for (i = 0; i < nw; i++) pthread_join(workers[i].tid, NULL);
+
+    report(workers, nw, count, now_ns() - t_begin);
+    return 0;
+}
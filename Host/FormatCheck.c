@@ -0,0 +1,122 @@
+/**
+ * @file    FormatCheck.c
+ * @author  严嘉哲
+ * @brief   Double2String 回归检查 (Linux)：固定用例表，加上随机单精度数与 C 库 "%.*e" 的逐个比较
+ * @version 1.0
+ * @date    2026-10-16
+ *
+ * 用法: format_check [随机个数]   (默认 1000000，0 表示只查用例表)
+ * 返回: 0 全部一致，1 有不一致 (逐条输出到标准错误，最多 20 条)
+ *
+ * C 库按精确值舍入，恰好落在两个候选正中间时取偶数；Double2String 此时向远离 0 的方向进位，
+ * 这类恰好居中的数在随机比较中跳过 (用例表中单独覆盖)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Middleware/Double2Str.h"
+
+typedef struct {
+    uint32_t bits;          // 单精度的位模式
+    const char *want;       // Double2String 应输出的字符串
+} FormatCase;
+
+static const FormatCase cases[] = {
+    { 0x1BB2A573UL, "2.95545E-22" },     // 2.95545489e-22: 先缩放再舍入时末位多进 1
+    { 0xB4F01565UL, "-4.47191E-07" },    // -4.47190502e-07: 末位少进 1
+    { 0x8D5E8784UL, "-6.85722E-31" },    // -6.85721526e-31
+    { 0x4B000001UL, "8388609" },         // 2^23 + 1: 加 0.5 后再次舍入会变成 8388610
+    { 0x4B7FFFFFUL, "16777215" },
+    { 0x3F800000UL, "1" },
+    { 0x3DCCCCCDUL, "0.1" },
+    { 0x42C80000UL, "100" },
+    { 0x49742400UL, "1000000" },
+    { 0x4E6E6B28UL, "1E+09" },
+    { 0x3C23D70AUL, "0.01" },
+    { 0x38D1B717UL, "0.0001" },
+    { 0x38D1B716UL, "0.0001" },          // 9.9999990e-05: 进位后指数变为 -4，改用定点
+    { 0x3727C5ACUL, "1E-05" },
+    { 0x3F7FFFFFUL, "1" },               // 0.99999994: 进位到下一个数量级
+    { 0x7F7FFFFFUL, "3.40282E+38" },
+    { 0x00800000UL, "1.17549E-38" },
+    { 0x00000001UL, "1.4013E-45" },
+    { 0x3E2AAAABUL, "0.166667" },        // 1/6
+    { 0x47C35000UL, "100000" },
+    { 0x4CBEBC20UL, "100000000" },
+    { 0x42C80100UL, "100.002" },         // 100.001953125
+    { 0x42C80200UL, "100.004" },         // 100.00390625
+    { 0x42C80800UL, "100.016" },         // 100.015625
+    { 0x42C81000UL, "100.031" },         // 100.03125
+    { 0x42C82000UL, "100.063" },         // 100.0625: 恰好居中，向远离 0 进位
+};
+
+static float from_bits(uint32_t u) {
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+/**
+ * @brief  C 库的参考结果: 与 Double2String 相同的有效位数，用 "%.*e" 按精确值舍入
+ * @return 1 表示该数恰好落在两个候选正中间 (舍入方向与 Double2String 不同，跳过)
+ */
+static int reference(float f, double *want) {
+    char buf[200], *p;
+    int e10, n, i;
+
+    snprintf(buf, sizeof(buf), "%.*e", PRECISION - 1, f);
+    e10 = atoi(strchr(buf, 'e') + 1);
+    n = (e10 >= PRECISION && e10 <= FIX_MAX_EXP) ? e10 + 1 : PRECISION;
+    snprintf(buf, sizeof(buf), "%.*e", n - 1, f);
+    *want = strtod(buf, NULL);
+
+    // 单精度数的十进制展开有限，160 位足以看出第 n 位之后是否恰为 "5000..."
+    snprintf(buf, sizeof(buf), "%.160e", f);
+    p = buf + ((buf[0] == '-') ? 1 : 0);
+    p += n + 1;                             // 跳过前 n 位与小数点
+    if (*p++ != '5') return 0;
+    for (i = 0; p[i] != 'e'; i++) {
+        if (p[i] != '0') return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    unsigned long count = (argc > 1) ? strtoul(argv[1], NULL, 0) : 1000000UL;
+    unsigned long i, bad = 0, ties = 0;
+    uint32_t seed = 12345;
+    char out[32];
+    double want;
+    float f;
+    size_t k;
+
+    for (k = 0; k < sizeof(cases) / sizeof(cases[0]); k++) {
+        Double2String(from_bits(cases[k].bits), out);
+        if (strcmp(out, cases[k].want) != 0) {
+            if (bad < 20) fprintf(stderr, "case 0x%08lX: got %s, want %s\n",
+                                  (unsigned long)cases[k].bits, out, cases[k].want);
+            bad++;
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        seed = seed * 1664525UL + 1013904223UL;
+        f = from_bits(seed);
+        if (f != f || f - f != 0.0f || f == 0.0f) continue;    // 只查有限非零数
+        if (reference(f, &want)) {
+            ties++;
+            continue;
+        }
+        Double2String(f, out);
+        if (strtod(out, NULL) != want) {
+            if (bad < 20) fprintf(stderr, "0x%08lX (%.9g): got %s, want %.*g\n",
+                                  (unsigned long)seed, f, out, 17, want);
+            bad++;
+        }
+    }
+
+    printf("format_check: %lu cases, %lu random (%lu exact ties skipped), %lu mismatches\n",
+           (unsigned long)(sizeof(cases) / sizeof(cases[0])), count, ties, bad);
+    return bad ? 1 : 0;
+}
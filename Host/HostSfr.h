@@ -0,0 +1,15 @@
+#ifndef __HOST_SFR_H__
+#define __HOST_SFR_H__
+
+/**
+ * @brief  主机编译时的特殊功能寄存器：驱动照常读写这些变量，没有任何硬件效果
+ *         (定义在 Host/VirtualDevice.c，定时器中断由虚拟时钟直接调用)
+ */
+extern volatile unsigned char P0, P1, P2, P3;
+extern volatile unsigned char PCON, TMOD, TL0, TH0, TL1, TH1;
+extern volatile unsigned char T2CON, RCAP2L, RCAP2H, TL2, TH2, SCON;
+extern volatile unsigned int SBUF;      // 收发寄存器共用一个变量，高位由虚拟设备用来区分是否刚被写入
+extern volatile unsigned char EA, ET0, ET1, ET2, EX0, EX1, ES, PT0, PT1, PT2, PS;
+extern volatile unsigned char TF0, TR0, TF1, TR1, TF2, TR2, IT0, IT1, IE0, IE1, TI, RI;
+
+#endif
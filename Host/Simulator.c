@@ -0,0 +1,256 @@
+/**
+ * @file    Simulator.c
+ * @author  严嘉哲
+ * @brief   虚拟设备模拟器 (Linux)：在虚拟设备上运行 main.c，按脚本按键，
+ *          逐次按键报告液晶总线流量与按键到画面稳定的延迟，可作为延迟预算的回归检查
+ * @version 1.0
+ * @date    2026-10-16
+ *
+ * 用法: calc_sim [-k 按键串] [-f 脚本文件] [-t 按住ms,间隔ms] [-s 起始ms] [-B 预算us] [-u 串口输入 [-o 串口输出]] [-q]
+ *   -k 依次按下的键，用键盘映射表中的字符表示 (如 "12+34=")，A 为 AC，C 为 CE，B 为退格，D 为 00
+ *   -f 脚本文件，每行 "<按下时刻ms> <键> [按住ms]"，'#' 开头为注释；时刻相对开机
+ *   -t 按键串中每个键按住的时间与两次按键之间的间隔 (默认 50,100)
+ *   -s 按键串的第一个键的按下时刻 (默认 1200，开机画面之后)
+ *   -B 延迟预算: 任一按键到画面稳定超过该值时返回 1
+ *   -u 从第 -s 毫秒起把文件内容经串口发给设备，末尾补 EOT (需用 UART_STREAM=1 编译)；
+ *   -o 设备回送数据的输出文件 (默认标准输出)
+ *   -q 不输出最终画面与汇总
+ *
+ * 输出: 有按键时标准输出为 CSV，每次按键一行: key,press_ms,writes,cmds,lcd_us,first_us,last_us
+ *       (first_us/last_us 为按下到第一次/最后一次液晶写入，无写入时为空)；
+ *       最终画面与汇总输出到标准错误
+ * 返回: 0 正常，1 超出预算、液晶忙时被写入或串口丢字节，2 参数错误，3 运行超时
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Middleware/Common.h"
+#include "../Drivers/KeyScan.h"
+#include "../Drivers/Timer0.h"
+#include "../Drivers/Uart.h"
+#include "VirtualDevice.h"
+
+extern u8 code KeyTable[];              // main.c 的按键映射表
+
+static VdEvent events[VD_MAX_EVENTS];
+static int n_events;
+
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-k keys] [-f script] [-t hold_ms,gap_ms] [-s start_ms] [-B budget_us]"
+            " [-u serial_in [-o serial_out]] [-q]\n", prog);
+    exit(2);
+}
+
+/**
+ * @brief  键盘字符 -> 按键编号
+ * @return 按键编号，不认识的字符返回 -1
+ */
+static int key_code(char c) {
+    int i;
+
+    for (i = 0; i < KEY_COUNT; i++) {
+        if (KeyTable[i] == (u8)c) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief  加入一次按键 (按下与松开两个事件)
+ */
+static void add_press(uint32_t at_ms, char c, uint32_t hold_ms) {
+    int key = key_code(c);
+
+    if (key < 0) {
+        fprintf(stderr, "unknown key '%c'\n", c);
+        exit(2);
+    }
+    if (n_events + 2 > VD_MAX_EVENTS) {
+        fprintf(stderr, "too many key events (max %d)\n", VD_MAX_EVENTS / 2);
+        exit(2);
+    }
+    events[n_events].at_us = at_ms * 1000;
+    events[n_events].key = (uint8_t)key;
+    events[n_events].down = 1;
+    events[n_events + 1].at_us = (at_ms + hold_ms) * 1000;
+    events[n_events + 1].key = (uint8_t)key;
+    events[n_events + 1].down = 0;
+    n_events += 2;
+}
+
+/**
+ * @brief  按时刻稳定排序 (插入排序，同一时刻保持脚本顺序)
+ */
+static void sort_events(void) {
+    VdEvent t;
+    int i, j;
+
+    for (i = 1; i < n_events; i++) {
+        t = events[i];
+        for (j = i; j > 0 && events[j - 1].at_us > t.at_us; j--) {
+            events[j] = events[j - 1];
+        }
+        events[j] = t;
+    }
+}
+
+static void load_script(const char *path) {
+    FILE *f = fopen(path, "r");
+    char line[128];
+    unsigned long at, hold;
+    char c;
+    int n, ln = 0;
+
+    if (!f) {
+        perror(path);
+        exit(2);
+    }
+    while (fgets(line, sizeof(line), f)) {
+        ln++;
+        if (line[0] == '#' || line[strspn(line, " \t\r\n")] == '\0') continue;
+        hold = 50;
+        n = sscanf(line, "%lu %c %lu", &at, &c, &hold);
+        if (n < 2) {
+            fprintf(stderr, "%s:%d: expected \"<at_ms> <key> [hold_ms]\"\n", path, ln);
+            exit(2);
+        }
+        add_press((uint32_t)at, c, (uint32_t)hold);
+    }
+    fclose(f);
+}
+
+/**
+ * @brief  读入串口发送的数据，末尾补 EOT (设备据此回送结束行)
+ */
+static char *load_serial(const char *path, uint32_t *n) {
+    FILE *f = fopen(path, "rb");
+    char *buf;
+    long len;
+
+    if (!f) {
+        perror(path);
+        exit(2);
+    }
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    rewind(f);
+    buf = malloc((size_t)len + 2);
+    if (!buf || fread(buf, 1, (size_t)len, f) != (size_t)len) {
+        perror(path);
+        exit(2);
+    }
+    fclose(f);
+    if (len && buf[len - 1] != '\n') buf[len++] = '\n';  // 最后一行也要有行尾
+    buf[len++] = 0x04;
+    *n = (uint32_t)len;
+    return buf;
+}
+
+static void print_us(uint32_t us) {
+    if (us != VD_NONE) printf("%lu", (unsigned long)us);
+}
+
+int main(int argc, char **argv) {
+    const char *keys = NULL, *script = NULL, *serial_in = NULL, *serial_out = NULL;
+    char *serial = NULL;
+    uint32_t serial_n = 0;
+    FILE *out = stdout;
+    unsigned long hold = 50, gap = 100, start = 1200, budget = 0, worst = 0;
+    int quiet = 0, over = 0, i;
+    uint32_t at;
+    char screen[2][17];
+    const VdStroke *s;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-k") && i + 1 < argc) {
+            keys = argv[++i];
+        } else if (!strcmp(argv[i], "-f") && i + 1 < argc) {
+            script = argv[++i];
+        } else if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+            if (sscanf(argv[++i], "%lu,%lu", &hold, &gap) != 2) usage(argv[0]);
+        } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            start = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "-B") && i + 1 < argc) {
+            budget = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "-u") && i + 1 < argc) {
+            serial_in = argv[++i];
+        } else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            serial_out = argv[++i];
+        } else if (!strcmp(argv[i], "-q")) {
+            quiet = 1;
+        } else {
+            usage(argv[0]);
+        }
+    }
+
+    if (script) load_script(script);
+    if (keys) {
+        for (at = (uint32_t)start; *keys; keys++, at += (uint32_t)(hold + gap)) {
+            add_press(at, *keys, (uint32_t)hold);
+        }
+    }
+    sort_events();
+    if (serial_in) {
+#if !UART_STREAM
+        fprintf(stderr, "-u needs a simulator built with UART_STREAM=1\n");
+        return 2;
+#endif
+        serial = load_serial(serial_in, &serial_n);
+        if (serial_out && !(out = fopen(serial_out, "wb"))) {
+            perror(serial_out);
+            return 2;
+        }
+        VD_Serial(serial, serial_n, (uint32_t)start * 1000, out);
+    }
+
+    VD_Run(events, n_events, 300000);
+    if (out != stdout) fclose(out);
+    free(serial);
+
+    if (n_events) printf("key,press_ms,writes,cmds,lcd_us,first_us,last_us\n");
+    for (i = n_events ? 0 : VD_Strokes; i < VD_Strokes; i++) {
+        s = &VD_Stroke[i];
+        if (s->key == VD_BOOT) printf("boot,");
+        else printf("%c,", KeyTable[s->key]);
+        printf("%lu,%lu,%lu,%lu,", (unsigned long)(s->press_us / 1000), (unsigned long)s->writes,
+               (unsigned long)s->cmds, (unsigned long)s->lcd_us);
+        print_us(s->first_us);
+        putchar(',');
+        print_us(s->last_us);
+        putchar('\n');
+        if (s->key != VD_BOOT && s->last_us != VD_NONE) {
+            if (s->last_us > worst) worst = s->last_us;
+            if (budget && s->last_us > budget) over++;
+        }
+    }
+
+    if (!quiet) {
+        VD_Screen(screen);
+        fprintf(stderr, "+----------------+\n|%s|\n|%s|\n+----------------+\n", screen[0], screen[1]);
+        fprintf(stderr, "time %.3f ms, %lu ticks (%u us), idle %.1f%%, %lu busy polls, %lu power-downs\n",
+                VD_Stats.now_us / 1000.0, (unsigned long)VD_Stats.ticks, (unsigned)TIMER0_TICK_US,
+                VD_Stats.ticks ? 100.0 * VD_Stats.idle_ticks / VD_Stats.ticks : 0.0,
+                (unsigned long)VD_Stats.polls, (unsigned long)VD_Stats.downs);
+        fprintf(stderr, "worst key-to-display latency %lu us", worst);
+        if (budget) fprintf(stderr, ", budget %lu us: %d over", budget, over);
+        fprintf(stderr, "\n");
+        if (serial_in) {
+            fprintf(stderr, "serial %lu bps: %lu bytes in, %lu out, %lu XOFF, %.1f%% of line time receiving\n",
+                    (unsigned long)UART_BAUD, (unsigned long)VD_Stats.rx_bytes, (unsigned long)VD_Stats.tx_bytes,
+                    (unsigned long)VD_Stats.xoffs,
+                    VD_Stats.now_us > start * 1000 ? 100.0 * VD_Stats.rx_bytes * (10000000.0 / UART_BAUD)
+                                                     / (VD_Stats.now_us - start * 1000) : 0.0);
+        }
+    }
+    if (VD_Stats.overruns) {
+        fprintf(stderr, "error: %lu serial bytes overran SBUF\n", (unsigned long)VD_Stats.overruns);
+    }
+    if (VD_Stats.busy_writes) {
+        fprintf(stderr, "error: %lu LCD writes while the controller was busy\n", (unsigned long)VD_Stats.busy_writes);
+    }
+    if (VD_Stats.timeout) {
+        fprintf(stderr, "error: display did not settle, stopped at %.3f ms\n", VD_Stats.now_us / 1000.0);
+        return 3;
+    }
+    return (over || VD_Stats.busy_writes || VD_Stats.overruns) ? 1 : 0;
+}
@@ -0,0 +1,376 @@
+/**
+ * @file    VirtualDevice.c
+ * @author  严嘉哲
+ * @brief   虚拟设备：特殊功能寄存器变量、虚拟时钟、脚本按键与 HD44780 液晶模型 (见 VirtualDevice.h)
+ * @version 1.0
+ * @date    2026-10-16
+ */
+#include <setjmp.h>
+#include <string.h>
+
+#include "VirtualDevice.h"
+#include "../Drivers/HAL.h"
+#include "../Drivers/Timer0.h"
+#include "../Drivers/LCD1602.h"
+#include "../Drivers/MatrixKey.h"
+#include "../Drivers/IndependentKey.h"
+#include "../Drivers/Uart.h"
+
+#define VD_LIMIT_US     10000000UL      // 最后一个事件之后最多再运行 10 秒
+#define VD_WAKE_KEY0    18              // P3.2 (INT0) 上的独立按键，可唤醒掉电模式
+#define VD_WAKE_KEY1    19              // P3.3 (INT1)
+
+void App_Main(void);                    // main.c 的 main()，主机编译时改名 (见 Makefile)
+
+// ============================================================
+// 1. 特殊功能寄存器 (见 HostSfr.h)
+// ============================================================
+volatile unsigned char P0 = 0xFF, P1 = 0xFF, P2 = 0xFF, P3 = 0xFF;
+volatile unsigned char PCON, TMOD, TL0, TH0, TL1, TH1;
+volatile unsigned char T2CON, RCAP2L, RCAP2H, TL2, TH2, SCON;
+volatile unsigned int SBUF;
+volatile unsigned char EA, ET0, ET1, ET2, EX0, EX1, ES, PT0, PT1, PT2, PS;
+volatile unsigned char TF0, TR0, TF1, TR1, TF2, TR2, IT0, IT1, IE0, IE1, TI, RI;
+
+// ============================================================
+// 2. 设备状态
+// ============================================================
+VdStroke VD_Stroke[VD_MAX_EVENTS + 1];
+int VD_Strokes;
+VdStats VD_Stats;
+
+static uint64_t vd_now;                 // 虚拟时间 (微秒)
+static uint64_t vd_next_tick;           // 下一个 Timer0 节拍
+static uint64_t vd_end;                 // 最后一次按键或串口收发 + 稳定时间
+static uint32_t vd_settle;
+static uint8_t vd_in_isr;
+static jmp_buf vd_exit;
+
+static const VdEvent *vd_ev;
+static int vd_ev_n, vd_ev_next;
+static uint32_t vd_keys;                // 按键原始状态位图，第 n 位为按键 n
+
+// HD44780: 每行 40 个 DDRAM 单元，屏幕显示从 vd_shift 开始的 16 列
+static char vd_ddram[2][40];
+static uint8_t vd_ac;                   // 地址计数器: 0x00~0x27 第一行，0x40~0x67 第二行
+static uint8_t vd_shift;
+static uint8_t vd_inc = 1;              // 输入方式: 1 写入后地址加一，0 减一
+static uint64_t vd_lcd_ready;           // 液晶执行完上一条指令的时刻
+
+// 串口: SBUF 的高位为标记，设备写入发送字节后高位为 0
+#define VD_SBUF_IDLE    0x100           // 没有新写入的发送字节
+#define VD_SBUF_RX      0x200           // 低 8 位为刚收到的字节
+#define VD_FRAME_US     (10000000UL / UART_BAUD)    // 8N1 一帧 10 位
+
+// ============================================================
+// 3. 虚拟时钟与按键
+// ============================================================
+
+/**
+ * @brief  执行到 at 为止的按键事件，每次按下开始一条新的统计项
+ */
+static void vd_apply_keys(uint64_t at) {
+    const VdEvent *e;
+    VdStroke *s;
+
+    while (vd_ev_next < vd_ev_n && vd_ev[vd_ev_next].at_us <= at) {
+        e = &vd_ev[vd_ev_next++];
+        if (!e->down) {
+            vd_keys &= ~(1UL << e->key);
+            continue;
+        }
+        vd_keys |= 1UL << e->key;
+        s = &VD_Stroke[VD_Strokes++];
+        memset(s, 0, sizeof(*s));
+        s->key = e->key;
+        s->press_us = e->at_us;
+        s->first_us = s->last_us = VD_NONE;
+    }
+}
+
+#if UART_STREAM
+// 串口状态 (只在 UART_STREAM 编译时存在)
+static const char *vd_rx;
+static uint32_t vd_rx_n, vd_rx_pos;
+static uint64_t vd_rx_next;             // 下一个字节的发送时刻
+static uint8_t vd_rx_paused;            // 已收到 XOFF
+static uint8_t vd_rx_lag;               // 暂停前还会发出的字节数
+static uint64_t vd_tx_done;             // 设备正在发送的字节完成的时刻 (0 为空闲)
+static FILE *vd_tx_out;
+
+/**
+ * @brief  设备写了 SBUF: 开始发送一帧，流控字符由主机一侧处理
+ */
+static void vd_uart_tx(void) {
+    uint8_t c;
+
+    if (SBUF >= VD_SBUF_IDLE) return;
+    c = (uint8_t)SBUF;
+    SBUF = VD_SBUF_IDLE;
+    VD_Stats.tx_bytes++;
+    vd_tx_done = vd_now + VD_FRAME_US;
+    if (c == UART_XOFF) {
+        VD_Stats.xoffs++;
+        vd_rx_paused = 1;
+        vd_rx_lag = VD_XOFF_LAG;
+    } else if (c == UART_XON) {
+        vd_rx_paused = 0;
+        if (vd_rx_next < vd_now) vd_rx_next = vd_now;
+    } else if (vd_tx_out) {
+        fputc(c, vd_tx_out);
+    }
+}
+
+/**
+ * @brief  串口一步 (每个节拍): 发送完成置 TI，按帧间隔送入一个字节置 RI，有标志时调用串口中断
+ *         (设备软件置 TI 启动发送时，也在这里响应)
+ */
+static void vd_uart_step(void) {
+    if (vd_tx_done && vd_now >= vd_tx_done) {
+        vd_tx_done = 0;
+        TI = 1;
+    }
+    if (vd_rx_pos < vd_rx_n && vd_now >= vd_rx_next && (!vd_rx_paused || vd_rx_lag)) {
+        if (vd_rx_paused) vd_rx_lag--;
+        if (RI) {
+            VD_Stats.overruns++;        // 上一个字节还在 SBUF 中，新字节丢失
+        } else {
+            SBUF = VD_SBUF_RX | (uint8_t)vd_rx[vd_rx_pos];
+            RI = 1;
+        }
+        vd_rx_pos++;
+        VD_Stats.rx_bytes++;
+        vd_rx_next += VD_FRAME_US;
+        if (vd_rx_next < vd_now) vd_rx_next = vd_now;
+    }
+    if ((RI || TI) && ES && EA) {
+        vd_in_isr = 1;
+        Uart_Isr();
+        vd_in_isr = 0;
+        vd_uart_tx();
+    }
+    if ((vd_rx_pos < vd_rx_n || vd_tx_done) && vd_end < vd_now + vd_settle) {
+        vd_end = vd_now + vd_settle;
+    }
+}
+
+void VD_Serial(const char *buf, uint32_t n, uint32_t at_us, FILE *out) {
+    vd_rx = buf;
+    vd_rx_n = n;
+    vd_rx_pos = 0;
+    vd_rx_next = at_us;
+    vd_tx_out = out;
+}
+#define vd_uart_idle()  (vd_rx_pos == vd_rx_n && !vd_tx_done)
+#else
+#define vd_uart_step()
+#define vd_uart_idle()  1
+
+void VD_Serial(const char *buf, uint32_t n, uint32_t at_us, FILE *out) {
+    (void)buf; (void)n; (void)at_us; (void)out;
+}
+#endif
+
+/**
+ * @brief  执行已到期的 Timer0 节拍 (定时器未启动或中断关闭时跳过)
+ */
+static void vd_run_ticks(uint8_t idle) {
+    while (vd_next_tick <= vd_now) {
+        vd_apply_keys(vd_next_tick);
+        vd_next_tick += TIMER0_TICK_US;
+        vd_uart_step();
+        if (!(TR0 && ET0 && EA)) continue;
+        VD_Stats.ticks++;
+        VD_Stats.idle_ticks += idle;
+        vd_in_isr = 1;
+        Timer0_Isr();
+        vd_in_isr = 0;
+    }
+}
+
+/**
+ * @brief  脚本结束且画面已稳定，或超过时限时结束运行
+ */
+static void vd_check_done(void) {
+    if (vd_now >= vd_end + VD_LIMIT_US) {
+        VD_Stats.timeout = 1;
+        longjmp(vd_exit, 1);
+    }
+    if (vd_ev_next == vd_ev_n && vd_now >= vd_end && !LCD_IsBusy() && vd_uart_idle()) {
+        longjmp(vd_exit, 1);
+    }
+}
+
+/**
+ * @brief  CPU 忙等消耗时间，期间照常响应节拍中断 (中断内不再嵌套)
+ */
+static void vd_advance(uint32_t us) {
+    vd_now += us;
+    if (!vd_in_isr) {
+        vd_run_ticks(0);
+    }
+}
+
+void HAL_Idle(void) {
+    if (vd_next_tick > vd_now) {
+        vd_now = vd_next_tick;
+    }
+    vd_run_ticks(1);
+    vd_check_done();
+}
+
+/**
+ * @brief  掉电模式: Timer0 停止，虚拟时间直接跳到下一次按下 P3.2/P3.3 的时刻，
+ *         其间的其他按键不产生节拍扫描，与实物一样被忽略
+ */
+void HAL_PowerDown(void) {
+    int i;
+
+    VD_Stats.downs++;
+    for (i = vd_ev_next; i < vd_ev_n; i++) {
+        if (vd_ev[i].down && (vd_ev[i].key == VD_WAKE_KEY0 || vd_ev[i].key == VD_WAKE_KEY1)) break;
+    }
+    if (i == vd_ev_n) {
+        longjmp(vd_exit, 1);            // 再没有能唤醒的按键，运行结束
+    }
+    vd_now = vd_ev[i].at_us;
+    vd_apply_keys(vd_now);
+    vd_next_tick = vd_now + TIMER0_TICK_US;
+}
+
+void HAL_Poll(void) {
+    HAL_Idle();
+}
+
+void HAL_Spin(unsigned int us) {
+    vd_advance(us);
+}
+
+unsigned int MatrixKeyRead() {
+    return (unsigned int)(vd_keys & 0xFFFF);
+}
+
+unsigned char IndependentKeyRead() {
+#if UART_STREAM
+    return (unsigned char)(vd_keys >> 16) & 0xFC;   // 与 IndependentKey.c 相同，P3.0/P3.1 为串口线
+#else
+    return (unsigned char)(vd_keys >> 16);
+#endif
+}
+
+// ============================================================
+// 4. HD44780 液晶模型
+// ============================================================
+
+unsigned char HAL_LcdBusy(void) {
+    VD_Stats.polls++;
+    vd_advance(VD_POLL_US);
+    return vd_now < vd_lcd_ready;
+}
+
+/**
+ * @brief  执行一条指令，返回执行时间
+ */
+static uint32_t vd_lcd_command(uint8_t cmd) {
+    if (cmd & 0x80) {                   // 设置 DDRAM 地址
+        vd_ac = cmd & 0x7F;
+    } else if (cmd & 0x40) {            // 设置 CGRAM 地址 (未使用)
+    } else if (cmd & 0x20) {            // 功能设置
+    } else if (cmd & 0x10) {            // 光标/画面移位
+        if (cmd & 0x08) {
+            vd_shift = (cmd & 0x04) ? (vd_shift + 39) % 40 : (vd_shift + 1) % 40;
+        } else {
+            vd_ac = (cmd & 0x04) ? vd_ac + 1 : vd_ac - 1;
+        }
+    } else if (cmd & 0x08) {            // 显示开关
+    } else if (cmd & 0x04) {            // 输入方式
+        vd_inc = (cmd & 0x02) ? 1 : 0;
+    } else if (cmd & 0x02) {            // 归位
+        vd_ac = 0;
+        vd_shift = 0;
+        return VD_LCD_LONG_US;
+    } else if (cmd & 0x01) {            // 清屏
+        memset(vd_ddram, ' ', sizeof(vd_ddram));
+        vd_ac = 0;
+        vd_shift = 0;
+        vd_inc = 1;
+        return VD_LCD_LONG_US;
+    }
+    return VD_LCD_CMD_US;
+}
+
+/**
+ * @brief  写数据: 存入 DDRAM，地址计数器在 0x27/0x40、0x67/0x00 之间回绕
+ */
+static void vd_lcd_data(uint8_t v) {
+    vd_ddram[vd_ac >= 0x40][(vd_ac & 0x3F) % 40] = (char)v;
+    if (vd_inc) {
+        vd_ac = (vd_ac == 0x27) ? 0x40 : ((vd_ac == 0x67) ? 0x00 : vd_ac + 1);
+    } else {
+        vd_ac = (vd_ac == 0x40) ? 0x27 : ((vd_ac == 0x00) ? 0x67 : vd_ac - 1);
+    }
+}
+
+void HAL_LcdWrite(unsigned char IsCmd, unsigned char Value) {
+    VdStroke *s = &VD_Stroke[VD_Strokes - 1];
+    uint32_t exec, dt;
+
+    if (vd_now < vd_lcd_ready) {
+        VD_Stats.busy_writes++;
+    }
+    if (IsCmd) {
+        exec = vd_lcd_command(Value);
+        s->cmds++;
+    } else {
+        vd_lcd_data(Value);
+        exec = VD_LCD_CMD_US;
+    }
+    vd_lcd_ready = vd_now + exec;
+
+    s->writes++;
+    s->lcd_us += exec;
+    dt = (uint32_t)(vd_now - s->press_us);
+    if (s->first_us == VD_NONE) {
+        s->first_us = dt;
+    }
+    s->last_us = dt;
+}
+
+void VD_Screen(char out[2][17]) {
+    uint8_t r, c;
+
+    for (r = 0; r < 2; r++) {
+        for (c = 0; c < 16; c++) {
+            out[r][c] = vd_ddram[r][(vd_shift + c) % 40];
+        }
+        out[r][16] = '\0';
+    }
+}
+
+// ============================================================
+// 5. 运行
+// ============================================================
+
+void VD_Run(const VdEvent *ev, int n, uint32_t settle_us) {
+    VdStroke *s;
+
+    vd_ev = ev;
+    vd_ev_n = n;
+    vd_ev_next = 0;
+    vd_settle = settle_us;
+    vd_end = (n ? ev[n - 1].at_us : 0) + (uint64_t)settle_us;
+    SBUF = VD_SBUF_IDLE;
+
+    // 上电时 DDRAM 内容不确定，这里填空格；开机阶段的写入计入 VD_BOOT 项
+    memset(vd_ddram, ' ', sizeof(vd_ddram));
+    s = &VD_Stroke[0];
+    memset(s, 0, sizeof(*s));
+    s->key = VD_BOOT;
+    s->first_us = s->last_us = VD_NONE;
+    VD_Strokes = 1;
+
+    if (!setjmp(vd_exit)) {
+        App_Main();
+    }
+    VD_Stats.now_us = vd_now;
+}
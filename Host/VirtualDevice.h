@@ -0,0 +1,92 @@
+/**
+ * @file    VirtualDevice.h
+ * @author  严嘉哲
+ * @brief   虚拟设备：在 Linux 上运行 main.c 的硬件抽象层后端 (见 Drivers/HAL.h)
+ *          虚拟时钟按 Timer0 节拍调用中断函数，按键按脚本按下/松开，
+ *          液晶按 HD44780 的指令集维护 2x40 的 DDRAM，并统计每次按键引起的总线写入与耗时，
+ *          蜂鸣器只写 Host/HostSfr.h 中的变量，不发声
+ * @version 1.0
+ * @date    2026-10-16
+ *
+ * 时间模型: CPU 运算不耗时 (按 0 计)，只有空闲等待、延时循环与忙标志轮询推进虚拟时钟，
+ *           因此测得的延迟反映消抖、调度、显示刷新周期与液晶总线的开销
+ */
+#ifndef __VIRTUAL_DEVICE_H__
+#define __VIRTUAL_DEVICE_H__
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define VD_MAX_EVENTS   2048            // 按键事件 (按下与松开各一个) 的上限
+#define VD_BOOT         0xFF            // 开机阶段的统计项 (不对应按键)
+#define VD_NONE         0xFFFFFFFFUL    // 没有液晶写入
+
+#define VD_LCD_CMD_US   37              // 普通指令与写数据的执行时间
+#define VD_LCD_LONG_US  1520            // 清屏、归位的执行时间
+#define VD_POLL_US      10              // 读一次忙标志的耗时 (约 10 个机器周期)
+#define VD_XOFF_LAG     8               // 主机收到 XOFF 后仍会发出的字节数
+
+typedef struct {
+    uint32_t at_us;                     // 发生时刻
+    uint8_t key;                        // 按键编号 (0~23)
+    uint8_t down;                       // 1 按下，0 松开
+} VdEvent;
+
+// 一次按键 (从按下到下一次按下之前) 引起的液晶流量
+typedef struct {
+    uint8_t key;                        // 按键编号，开机阶段为 VD_BOOT
+    uint32_t press_us;                  // 按下时刻
+    uint32_t writes;                    // 总线写入次数
+    uint32_t cmds;                      // 其中的命令数
+    uint32_t lcd_us;                    // 液晶执行这些写入的时间
+    uint32_t first_us;                  // 按下到第一次写入 (无写入时为 VD_NONE)
+    uint32_t last_us;                   // 按下到最后一次写入，即按键到画面稳定的延迟
+} VdStroke;
+
+typedef struct {
+    uint64_t now_us;                    // 结束时的虚拟时间
+    uint32_t ticks;                     // Timer0 节拍数
+    uint32_t idle_ticks;                // 其中 CPU 处于空闲模式的节拍数
+    uint32_t polls;                     // 读忙标志的次数
+    uint32_t busy_writes;               // 液晶仍忙时的写入 (真实液晶会丢弃)
+    uint32_t downs;                     // 进入掉电模式的次数
+    uint32_t rx_bytes;                  // 串口: 主机发给设备的字节数
+    uint32_t tx_bytes;                  // 串口: 设备回送的字节数 (含流控字符)
+    uint32_t xoffs;                     // 串口: 设备发出 XOFF 的次数
+    uint32_t overruns;                  // 串口: 设备还没取走上一个字节又收到新字节 (丢失)
+    uint8_t timeout;                    // 1 表示超过时限仍未空闲，被强制结束
+} VdStats;
+
+extern VdStroke VD_Stroke[VD_MAX_EVENTS + 1];
+extern int VD_Strokes;
+extern VdStats VD_Stats;
+
+/**
+ * @brief  按脚本运行 main.c，直到最后一个事件之后 settle_us 且液晶队列已空
+ * @param  ev       按时间排序的按键事件
+ * @param  n        事件数
+ * @param  settle_us 最后一个事件之后至少再运行的时间
+ * @return 无 (结果见 VD_Stroke/VD_Stats)
+ */
+void VD_Run(const VdEvent *ev, int n, uint32_t settle_us);
+
+/**
+ * @brief  设置串口数据 (仅 UART_STREAM 编译时有效)：开机画面之后按 UART_BAUD 的帧间隔逐字节发给设备，
+ *         遵守设备发出的 XON/XOFF (收到 XOFF 后仍会发出 VD_XOFF_LAG 个字节，模拟主机 UART 的 FIFO)；
+ *         设备回送的字节 (流控字符除外) 写入 out
+ * @param  buf  发送的数据
+ * @param  n    字节数
+ * @param  at_us 第一个字节的发送时刻
+ * @param  out  回送数据的输出
+ * @return 无
+ */
+void VD_Serial(const char *buf, uint32_t n, uint32_t at_us, FILE *out);
+
+/**
+ * @brief  取液晶当前可见的两行 (考虑显示移位)
+ * @param  out 两行各 16 个字符，以 '\0' 结尾
+ * @return 无
+ */
+void VD_Screen(char out[2][17]);
+
+#endif
@@ -6,21 +6,20 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+#include "Compiler.h"
+
 // 错误码定义
 #define ERR_OK     0
 #define ERR_SYNTAX 1
 #define ERR_DIV0   2
+#define ERR_OVERFLOW 3
 
 // Lexer 处理结果
 #define LEX_CONSUMED  1  // Lexer处理了这个字符 (它是数字或点)
 #define LEX_REJECTED  0  // Lexer不认这个字符 (它是运算符)
 
-// --- 变量类型简写 ---
-typedef char           s8;
-typedef int            s16;
-typedef unsigned char  u8;
-typedef unsigned int   u16;
-typedef double         f64;
+// 编译期断言 (C89 兼容：条件不成立时数组长度为 -1，编译报错)
+#define STATIC_ASSERT(cond, name) typedef char static_assert_##name[(cond) ? 1 : -1]
 
 /**
  * @brief Token 类型枚举
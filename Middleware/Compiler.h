@@ -0,0 +1,76 @@
+/**
+ * @file Compiler.h
+ * @brief 编译器适配层 (Keil C51 / SDCC / 主机 gcc)
+ *
+ * 源码统一按 Keil C51 的写法使用 code/xdata/idata/pdata/data/bit 关键字，
+ * 在 SDCC 下映射为带下划线的存储类，在主机编译时映射为空。
+ * sbit 与中断函数的语法在两种编译器之间无法用简单替换兼容，统一使用
+ * SBIT() / INTERRUPT() 宏书写，空操作指令统一用 NOP()。
+ * u8/u16/u32 等类型简写也在此按 C51 的位宽定义，主机编译的驱动与固件做相同的回绕运算。
+ */
+
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#if defined(__C51__)
+    // --- Keil C51 ---
+    #define COMPILER_KEIL 1
+    #include <intrins.h>
+    #define NOP()                   _nop_()
+    #define SBIT(name, addr, pos)   sbit name = (addr) ^ (pos)
+    #define INTERRUPT(n)            interrupt n
+    #define REENTRANT               reentrant
+
+#elif defined(__SDCC) || defined(SDCC)
+    // --- SDCC (mcs51) ---
+    #define COMPILER_SDCC 1
+    #define code    __code
+    #define xdata   __xdata
+    #define idata   __idata
+    #define pdata   __pdata
+    #define data    __data
+    #define bit     __bit
+    #define SBIT(name, addr, pos)   __sbit __at((addr) + (pos)) name
+    #define INTERRUPT(n)            __interrupt(n)
+    #define REENTRANT               __reentrant
+    #define NOP()                   __asm__("nop")
+
+#else
+    // --- 主机编译 (仅用于中间件，无 SFR) ---
+    #define COMPILER_HOST 1
+    #define code
+    #define xdata
+    #define idata
+    #define pdata
+    #define data
+    #define bit     unsigned char
+    #define SBIT(name, addr, pos)   unsigned char name
+    #define INTERRUPT(n)
+    #define REENTRANT
+    #define NOP()                   ((void)0)
+#endif
+
+// --- 变量类型简写 (驱动与中间件共用，按 C51 的位宽固定) ---
+#if defined(COMPILER_HOST)
+// 主机编译时 int/long 宽度与 C51 不同，整数类型按 C51 的位宽固定 (定点运算依赖 32 位回绕)
+// C51 的 double 实为 IEEE-754 单精度，主机上 f64 同样取 float，配合 -fsingle-precision-constant
+// 与 -ffp-contract=off 编译，浮点运算与格式化结果和固件逐位一致
+#include <stdint.h>
+typedef char           s8;
+typedef int16_t        s16;
+typedef uint8_t        u8;
+typedef uint16_t       u16;
+typedef int32_t        s32;
+typedef uint32_t       u32;
+typedef float          f64;
+#else
+typedef char           s8;
+typedef int            s16;
+typedef unsigned char  u8;
+typedef unsigned int   u16;
+typedef long           s32;
+typedef unsigned long  u32;
+typedef double         f64;
+#endif
+
+#endif // COMPILER_H
@@ -1,67 +1,224 @@
 #include "Double2Str.h"
+#include "Pow10.h"
+
+// 逐位"减法计数"求商，替代 32 位的 /10 与 %10 库调用
+#define POW10(n)   (Pow10U32[n])   // 10^n，n = 0~9
+
+// 舍入校正用的大整数：u16 小端分段，192 位可容纳任意单精度数与舍入中点的精确比较
+// (最大约 2^24 × 5^50 ≈ 2^140)
+#define BIG_LIMBS  12
+#define POW5_STEP  6               // 每次乘 5^6 = 15625，不超过 u16
+#define POW5_6     15625U
+
+// 工作区 (xdata)，不可重入；主机编译时每个线程一份 (与 NumBcd.c 相同)
+#if defined(COMPILER_HOST)
+#define WK_STATIC   static _Thread_local
+#else
+#define WK_STATIC   static
+#endif
+WK_STATIC u16 xdata big_l[BIG_LIMBS];
+WK_STATIC u16 xdata big_r[BIG_LIMBS];
 
 /**
- * @brief 计算一个长整数的位数
- * @param num 输入整数
- * @return 位数 (例如 123 -> 3, 0 -> 1)
+ * @brief 判断浮点数是否为 Inf/NaN
+ * @param f 输入浮点数
+ * @return F64_FINITE / F64_INF / F64_NAN
  */
-static u16 get_int_length(long num) {
-    u16 len = 0;
-    if (num == 0) return 1;
-    // 负数处理（虽然本逻辑中传入的都是绝对值，但保险起见）
-    if (num < 0) num = -num; 
-    
-    while (num > 0) {
-        num /= 10;
-        len++;
-    }
-    return len;
+u8 F64_Class(f64 f) {
+#if defined(COMPILER_HOST)
+    if (f != f) return F64_NAN;
+    if (f - f != 0.0) return F64_INF;
+    return F64_FINITE;
+#else
+    // C51 的 f64 实为 IEEE-754 单精度：阶码全 1 即为 Inf/NaN
+    union { f64 f; u32 u; } bits;
+    bits.f = f;
+    if ((bits.u & 0x7F800000UL) != 0x7F800000UL) return F64_FINITE;
+    return (bits.u & 0x007FFFFFUL) ? F64_NAN : F64_INF;
+#endif
+}
+
+/**
+ * @brief 计算 f * 10^e (|e| <= 10 时只有一次舍入)
+ * @param f 输入浮点数
+ * @param e 十进制指数
+ * @return 缩放结果
+ */
+static f64 scale10(f64 f, s16 e) {
+    u8 k;
+    while (e > 0) {
+        k = (e > POW10_F64_MAX) ? POW10_F64_MAX : (u8)e;
+        f *= Pow10F64[k];
+        e -= k;
+    }
+    while (e < 0) {
+        k = (e < -POW10_F64_MAX) ? POW10_F64_MAX : (u8)(-e);
+        f /= Pow10F64[k];
+        e += k;
+    }
+    return f;
+}
+
+/**
+ * @brief 大整数赋值为 32 位整数
+ */
+static void big_set(u16 *a, u32 v) {
+    u8 i;
+    a[0] = (u16)v;
+    a[1] = (u16)(v >> 16);
+    for (i = 2; i < BIG_LIMBS; i++) {
+        a[i] = 0;
+    }
+}
+
+/**
+ * @brief 大整数乘以 5^k
+ */
+static void big_mul_pow5(u16 *a, u8 k) {
+    u32 t;
+    u16 m;
+    u8 i;
+
+    while (k > 0) {
+        if (k >= POW5_STEP) {
+            m = POW5_6;
+            k -= POW5_STEP;
+        } else {
+            for (m = 1; k > 0; k--) {
+                m *= 5;
+            }
+        }
+        t = 0;
+        for (i = 0; i < BIG_LIMBS; i++) {
+            t += (u32)a[i] * m;
+            a[i] = (u16)t;
+            t >>= 16;
+        }
+    }
 }
 
 /**
- * @brief 将 long 转换为字符串并追加到 buf
- * @param num 待转换的数字
+ * @brief 大整数左移 bits 位
+ */
+static void big_shl(u16 *a, u16 bits) {
+    u8 q = (u8)(bits >> 4);
+    u8 r = (u8)(bits & 15);
+    u8 i;
+
+    for (i = BIG_LIMBS; i > 0; i--) {
+        a[i - 1] = (i > q) ? a[i - 1 - q] : 0;
+    }
+    if (r) {
+        for (i = BIG_LIMBS - 1; i > 0; i--) {
+            a[i] = (a[i] << r) | (a[i - 1] >> (16 - r));
+        }
+        a[0] <<= r;
+    }
+}
+
+/**
+ * @brief 比较两个大整数
+ * @return -1 / 0 / 1
+ */
+static s8 big_cmp(const u16 *a, const u16 *b) {
+    u8 i;
+    for (i = BIG_LIMBS; i > 0; i--) {
+        if (a[i - 1] != b[i - 1]) return (a[i - 1] > b[i - 1]) ? 1 : -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 精确判断正数 f 是否不小于舍入中点 (d + 0.5) × 10^s
+ *        f = m × 2^e 时比较 m × 2^(e+1-s) 与 (2d+1) × 5^s，两边都化为整数后逐段比较
+ * @param f 输入正数 (有限值)
+ * @param d 候选有效数字 (不超过 10^10)
+ * @param s 候选有效数字末位的十进制指数
+ * @return 1 表示 f >= 中点，应进位
+ */
+static u8 above_mid(f64 f, u32 d, s16 s) {
+    union { f64 f; u32 u; } bits;
+    u32 m;
+    s16 e;
+
+    // C51 与主机的 f64 都是 IEEE-754 单精度
+    bits.f = f;
+    m = bits.u & 0x007FFFFFUL;
+    e = (s16)((bits.u >> 23) & 0xFF);
+    if (e == 0) {
+        e = -149;                   // 非规格化数
+    } else {
+        m |= 0x00800000UL;
+        e -= 150;
+    }
+
+    big_set(big_l, m);
+    big_set(big_r, 2 * d + 1);
+    if (s >= 0) {
+        big_mul_pow5(big_r, (u8)s);
+    } else {
+        big_mul_pow5(big_l, (u8)(-s));
+    }
+    e = e + 1 - s;
+    if (e >= 0) {
+        big_shl(big_l, (u16)e);
+    } else {
+        big_shl(big_r, (u16)(-e));
+    }
+    return big_cmp(big_l, big_r) >= 0;
+}
+
+/**
+ * @brief 估算正数的十进制指数 (即 floor(log10(f))，可能差 1，由调用方修正)
+ * @param f 输入正数
+ * @return 十进制指数
+ */
+static s16 estimate_exp10(f64 f) {
+    s16 e10 = 0;
+    u8 k;
+    while (f >= Pow10F64[POW10_F64_MAX]) {
+        f /= Pow10F64[POW10_F64_MAX];
+        e10 += POW10_F64_MAX;
+    }
+    while (f < 1.0) {
+        f *= Pow10F64[POW10_F64_MAX];
+        e10 -= POW10_F64_MAX;
+    }
+    // 此时 1 <= f < 10^10，查表比较即可
+    k = POW10_F64_MAX - 1;
+    while (k > 0 && f < Pow10F64[k]) {
+        k--;
+    }
+    return e10 + k;
+}
+
+/**
+ * @brief 将 n 位整数按位追加到 buf (从高位到低位一次输出，无需翻转)
+ * @param num 待输出的整数 (不足 n 位时高位补 0)
+ * @param n 输出位数 (1~10)
+ * @param int_digits 小数点前的位数，小于 n 时在其后插入 '.'
  * @param buf 目标缓冲区指针
  * @param current_len 当前缓冲区长度指针 (会被更新)
- * @param min_width 最小显示宽度 (用于小数部分补前导0，整数部分填0即可)
  */
-static void long_to_str(long num, char *buf, u16 *current_len, u16 min_width) {
-    char xdata temp_buf[12]; // 临时存放翻转前的数字
-    u16 temp_idx = 0;
-    u16 i;
-
-    // 1. 提取每一位
-    if (num == 0) {
-        // 如果是0，且要求宽度为0，则什么都不干；否则至少填一个0
-        if (min_width == 0) min_width = 1;
-        // 这里将在补零逻辑中统一处理
-    } 
-    
-    while (num > 0) {
-        temp_buf[temp_idx++] = (num % 10) + '0';
-        num /= 10;
-    }
-
-    // 2. 补前导零 (对于小数部分 crucial)
-    // 例如 frac=5, width=3 -> 应输出 "005"。当前 temp="5"，需要补2个0
-    while (temp_idx < min_width) {
-        temp_buf[temp_idx++] = '0';
-    }
-    
-    // 如果原数是0且没进入循环，补一个0 (针对整数部分 num=0 的情况)
-    if (temp_idx == 0) {
-        temp_buf[temp_idx++] = '0';
-    }
-
-    // 3. 翻转并追加到主 buffer
-    for (i = 0; i < temp_idx; i++) {
-        buf[*current_len] = temp_buf[temp_idx - 1 - i];
-        (*current_len)++;
+static void digits_to_str(u32 num, u8 n, u8 int_digits, char *buf, u16 *current_len) {
+    u8 i;
+    char c;
+
+    for (i = n; i > 0; i--) {
+        if (n - i == int_digits) {
+            buf[(*current_len)++] = '.';
+        }
+        c = '0';
+        while (num >= Pow10U32[i - 1]) {
+            num -= Pow10U32[i - 1];
+            c++;
+        }
+        buf[(*current_len)++] = c;
     }
 }
 
 /**
- * @brief 去除字符串末尾多余的 '0' 和 '.'
+ * @brief 去除字符串末尾多余的 '0' 和 '.' (仅在已写出小数点时调用)
  */
 static void trim_zeros(char *buf, u16 *len) {
     // 只要最后一位是 '0'，就回退
@@ -76,90 +233,135 @@ static void trim_zeros(char *buf, u16 *len) {
     buf[*len] = '\0';
 }
 
+/**
+ * @brief 追加指数部分，例如 "E+12"、"E-05" (至少两位)
+ * @param e10 十进制指数
+ * @param buf 目标缓冲区指针
+ * @param len 当前缓冲区长度指针 (会被更新)
+ */
+static void append_exp(s16 e10, char *buf, u16 *len) {
+    buf[(*len)++] = 'E';
+    if (e10 < 0) {
+        buf[(*len)++] = '-';
+        e10 = -e10;
+    } else {
+        buf[(*len)++] = '+';
+    }
+    digits_to_str((u32)e10, (e10 >= 100) ? 3 : 2, 3, buf, len);
+    buf[*len] = '\0';
+}
+
 // ============================================================
 // 主函数实现
 // ============================================================
 /**
- * @brief 将double转换为字符串 (支持有效数字逻辑)
+ * @brief 将double转换为字符串 (按有效数字四舍五入，自动选择定点或科学计数法)
  * @param f   传入的浮点数
  * @param buf 输出缓冲区的指针 (建议长度至少为15字节)
  */
 void Double2String(f64 f, char *buf) {
-    long scaled_val;
-    long int_part;
-    long frac_part;
+    f64 scaled;
+    u32 digits;
     u16 len = 0;
-    s16 decimal_places = 0;
-    long multiplier = 1;
-    u16 i;
-    
-    // 1. 0值处理
+    s16 e10;
+    u8 n;
+    u8 fixed;
+    u8 retry;
+
+    // 1. 特殊值处理
+    switch (F64_Class(f)) {
+        case F64_NAN:
+            buf[0] = 'N'; buf[1] = 'a'; buf[2] = 'N'; buf[3] = '\0';
+            return;
+        case F64_INF:
+            if (f < 0) buf[len++] = '-';
+            buf[len++] = 'I'; buf[len++] = 'n'; buf[len++] = 'f';
+            buf[len] = '\0';
+            return;
+    }
+
+    // 2. 0值处理
     if (f == 0.0) {
         buf[0] = '0'; buf[1] = '\0'; return;
     }
 
-    // 2. 负号处理
+    // 3. 负号处理
     if (f < 0) {
         buf[len++] = '-';
         f = -f;
     }
 
-    // 3. 计算小数位数 (核心修改部分)
-    int_part = (long)f;
-    
-    if (int_part == 0) {
-        // --- 针对纯小数 (0.xxxxx) 的特殊处理 ---        
-        f64 temp_f = f;
-        u16 leading_zeros = 0;
-        
-        // 统计小数点后紧跟的0的个数
-        while (temp_f < 0.1 && leading_zeros < 8) {
-            temp_f *= 10.0;
-            leading_zeros++;
+    // 4. 确定十进制指数与有效数字
+    //    定点表示时整数部分全部显示 (最多 FIX_MAX_EXP + 1 位)，其余情况保留 PRECISION 位
+    e10 = estimate_exp10(f);
+    for (retry = 0; retry < 3; retry++) {
+        fixed = (e10 >= FIX_MIN_EXP && e10 <= FIX_MAX_EXP);
+        n = (fixed && e10 >= PRECISION) ? (u8)(e10 + 1) : PRECISION;
+        scaled = scale10(f, (s16)(n - 1) - e10);
+        digits = (u32)scaled;
+        // scaled 已舍入过一次 (缩放超过 10^10 时不止一次)，截断值可能差 1：
+        // 与精确的舍入中点比较，得到 f 按四舍五入的有效数字
+        while (above_mid(f, digits, e10 - (s16)(n - 1))) {
+            digits++;
+        }
+        while (digits > 0 && !above_mid(f, digits - 1, e10 - (s16)(n - 1))) {
+            digits--;
         }
-        
-        // 需要的小数位 = 要求的有效位数 + 前导零个数
-        decimal_places = PRECISION + leading_zeros;
-        
-    } else {
-        // --- 针对 >= 1.0 的数字，保持原有逻辑 ---
-        u16 int_len = get_int_length(int_part);
-        decimal_places = PRECISION - int_len;
-    }
-
-    // --- 边界与溢出保护 ---
-    if (decimal_places < 0) decimal_places = 0;
-    
-    // C51 long (32位) 最大约为 21亿 (2.1 * 10^9)。
-    // multiplier 最大只能是 10^9 (即9位小数)，否则计算 scaled_val 时会溢出。
-    // 这里的限制稍微放宽一点到 8 或 9，以支持更精确的小数显示。
-    if (decimal_places > 8) decimal_places = 8; 
 
-    // 4. 计算乘数因子
-    for (i = 0; i < decimal_places; i++) {
-        multiplier *= 10;
+        if (digits >= POW10(n - 1) * 10) {
+            e10++;                  // 四舍五入进位，例如 9.999999 -> 10.0000
+        } else if (digits < POW10(n - 1)) {
+            e10--;                  // 指数估算偏大
+        } else {
+            break;
+        }
     }
 
-    // 5. 整体缩放 + 四舍五入
-    // 注意：如果 f 很小 (0.000001)，multiplier 很大，乘积结果通常不会溢出 long
-    scaled_val = (long)(f * multiplier + 0.5);
-
-    // 6. 分离整数和小数
-    int_part = scaled_val / multiplier;
-    frac_part = scaled_val % multiplier;
-
-    // 7. 转换整数部分
-    long_to_str(int_part, buf, &len, 0);
-
-    // 8. 处理小数部分
-    if (decimal_places > 0) {
+    // 5. 输出
+    if (!fixed) {
+        // 科学计数法: d.ddddd E±xx
+        digits_to_str(digits, n, 1, buf, &len);
+        trim_zeros(buf, &len);
+        append_exp(e10, buf, &len);
+    } else if (e10 < 0) {
+        // 纯小数: 0.00ddddd
+        buf[len++] = '0';
         buf[len++] = '.';
-        // 传入 decimal_places 确保自动补前导零
-        long_to_str(frac_part, buf, &len, decimal_places);
-        
-        // 9. 清理末尾零
+        for (e10 = -e10 - 1; e10 > 0; e10--) {
+            buf[len++] = '0';
+        }
+        digits_to_str(digits, n, n, buf, &len);
+        trim_zeros(buf, &len);
+    } else if (e10 + 1 < n) {
+        // 带小数: ddd.ddd
+        digits_to_str(digits, n, (u8)(e10 + 1), buf, &len);
         trim_zeros(buf, &len);
     } else {
+        // 整数
+        digits_to_str(digits, n, n, buf, &len);
         buf[len] = '\0';
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 将长整型转换为十进制字符串 (整数结果的快速路径，只用减法计数取数)
+ * @param v   传入的整数 (不可为 -2^31)
+ * @param buf 输出缓冲区的指针 (至少 12 字节)
+ */
+void Long2String(s32 v, char *buf) {
+    u32 u;
+    u16 len = 0;
+    u8 n = 1;
+
+    if (v < 0) {
+        buf[len++] = '-';
+        u = (u32)-v;
+    } else {
+        u = (u32)v;
+    }
+    while (n <= POW10_U32_MAX && u >= POW10(n)) {
+        n++;
+    }
+    digits_to_str(u, n, n, buf, &len);
+    buf[len] = '\0';
+}
@@ -1,15 +1,39 @@
 #ifndef __FLOAT2STR_H__
 #define __FLOAT2STR_H__
 
-#define PRECISION 6  // 小数位数
+#define PRECISION 6      // 有效数字位数
+
+// 十进制指数在 [FIX_MIN_EXP, FIX_MAX_EXP] 内用定点表示，否则用科学计数法
+// (最长输出如 "-0.000123457"、"-1.23457E-05"，不超过 LCD 一行)
+#define FIX_MIN_EXP (-4)
+#define FIX_MAX_EXP 8
 
 #include "Common.h"
 
+// 特殊值分类 (F64_Class 的返回值)
+#define F64_FINITE 0
+#define F64_INF    1
+#define F64_NAN    2
+
+/**
+ * @brief 判断浮点数是否为 Inf/NaN (数值后端据此把运算溢出报告为 NUM_ERR_OVERFLOW)
+ * @param f 输入浮点数
+ * @return F64_FINITE / F64_INF / F64_NAN
+ */
+u8 F64_Class(f64 f);
+
 /**
- * @brief 将double转换为字符串
+ * @brief 将double转换为字符串 (支持 Inf/NaN 与科学计数法)
  * @param f   传入的浮点数
  * @param buf 输出缓冲区的指针 (建议长度至少为15字节)
  */
 void Double2String(f64 f, char *buf);
 
-#endif
\ No newline at end of file
+/**
+ * @brief 将长整型转换为十进制字符串 (不经过浮点运算，全部位数原样输出)
+ * @param v   传入的整数 (不可为 -2^31)
+ * @param buf 输出缓冲区的指针 (至少 12 字节)
+ */
+void Long2String(s32 v, char *buf);
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * @file    IntMath.c
+ * @author  严嘉哲
+ * @brief   32 位整数辅助运算：带溢出检测的乘法与二进制 GCD
+ * @version 1.0
+ * @date    2026-10-16
+ */
+#include "IntMath.h"
+
+/**
+ * @brief  无符号乘法，积不超过 INT_MAX_MAG 时写入 r
+ *         只用两次 16×16 乘法判断溢出，不需要 64 位中间结果
+ * @param  a 乘数
+ * @param  b 乘数
+ * @param  r 积
+ * @return u8 1 表示成功，0 表示溢出
+ */
+u8 Int_MulU31(u32 a, u32 b, u32 *r) {
+    u32 hi, lo;
+
+    if (a < b) {            // 让 b 为较小的一个
+        lo = a; a = b; b = lo;
+    }
+    if (b >> 16) return 0;  // 两个都不小于 2^16，积至少 2^32
+    hi = (u32)(u16)(a >> 16) * (u16)b;
+    if (hi >> 15) return 0;
+    hi <<= 16;
+    lo = (u32)(u16)a * (u16)b;
+    if (lo > INT_MAX_MAG - hi) return 0;
+    *r = lo + hi;
+    return 1;
+}
+
+/**
+ * @brief  最大公约数 (Stein 二进制算法)：只用移位、比较与减法，不调用长整型除法库
+ * @param  a 非负整数
+ * @param  b 非负整数
+ * @return u32 gcd(a, b)，其中一个为 0 时返回另一个
+ */
+u32 Int_Gcd(u32 a, u32 b) {
+    u32 t;
+    u8 shift = 0;
+
+    if (a == 0) return b;
+    if (b == 0) return a;
+
+    // 公共的因子 2
+    while (!((a | b) & 1)) {
+        a >>= 1;
+        b >>= 1;
+        shift++;
+    }
+    while (!(a & 1)) a >>= 1;
+    do {
+        while (!(u8)b) b >>= 8;             // 整字节的 0 一次移掉
+        while (!(b & 1)) b >>= 1;
+        if (a > b) {
+            t = b; b = a; a = t;
+        }
+        b -= a;
+    } while (b);
+    return a << shift;
+}
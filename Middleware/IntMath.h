@@ -0,0 +1,12 @@
+#ifndef __INTMATH_H__
+#define __INTMATH_H__
+
+#include "Common.h"
+
+// 32 位整数辅助运算，整数优先与分数数值后端共用
+#define INT_MAX_MAG 0x7FFFFFFFUL    // 可用的最大幅值 (不使用 -2^31，正负对称，取反不会溢出)
+
+u8  Int_MulU31(u32 a, u32 b, u32 *r);   // 积不超过 INT_MAX_MAG 时返回 1
+u32 Int_Gcd(u32 a, u32 b);              // 二进制 GCD，只用移位与减法
+
+#endif
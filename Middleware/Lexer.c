@@ -2,12 +2,12 @@
  * @file    Lexer.c
  * @author  严嘉哲
  * @brief   词法分析器实现文件，负责将输入字符转换为令牌流
- * @version 1.1
- * @date    2026-01-18
+ * @version 1.4
+ * @date    2026-10-16
  */
 
 #include "Lexer.h"
-#include <ctype.h>
+#include "Double2Str.h"
 
 // ============================================================
 // 1. 数据与定义
@@ -24,300 +24,369 @@ typedef enum {
     EVT_LPAREN,   // (
     EVT_RPAREN,   // )
     EVT_END,      // = (对应 TOK_END)
-    EVT_OTHER     // 其他非法字符
+    EVT_OTHER,    // 其他非法字符
+    EVT_COUNT     // 定义状态机表的列数
 } EventType;
 
-typedef TokenType (*ActionFunc)(char key);
-
-typedef struct {
-    InputState cur_state;
-    EventType  evt;
-    InputState next_state;
-    ActionFunc action;
-} FSM_Item;
-
-static f64 xdata current_val = 0.0;
-static f64 xdata frac_scale = 0.1;
-static s8  xdata val_sign = 1;
-static InputState xdata fsm_state = STATE_IDLE;
+// 动作码 (替代函数指针，避免间接调用破坏 Keil 的覆盖分析)
+// 0~8 与 TokenType 一一对应：不改动数值，直接返回该 Token
+typedef enum {
+    ACT_IGNORE   = TOK_NUM,     // 忽略输入，保持拼数
+    ACT_OP_ADD   = TOK_ADD,
+    ACT_OP_SUB   = TOK_SUB,
+    ACT_OP_MUL   = TOK_MUL,
+    ACT_OP_DIV   = TOK_DIV,
+    ACT_OP_LPA   = TOK_LPAREN,
+    ACT_OP_RPA   = TOK_RPAREN,
+    ACT_OP_END   = TOK_END,
+    ACT_ERROR    = TOK_ERROR,
+    // 拼数动作 (修改数值，返回 TOK_NUM)
+    ACT_INIT_NUM,               // 开始新数字
+    ACT_SET_SIGN,               // 负号开头
+    ACT_INIT_DOT,               // 小数点开头 (0.)
+    ACT_ADD_INT,                // 累加整数位
+    ACT_ADD_FRAC,               // 累加小数位
+    ACT_COUNT
+} ActionCode;
+
+// 表项: 高 4 位为下个状态，低 4 位为动作码
+#define CELL(next, act)     (u8)(((next) << 4) | (act))
+#define CELL_NEXT(cell)     ((InputState)((cell) >> 4))
+#define CELL_ACT(cell)      ((cell) & 0x0F)
+
+// 一行必须恰好给出 EVT_COUNT 个表项，少写或多写都会在预处理阶段报错
+#define FSM_ROW(digit, dot, minus, plus, mul, div, lpa, rpa, end, other) \
+    { digit, dot, minus, plus, mul, div, lpa, rpa, end, other }
+
+STATIC_ASSERT(STATE_MAX <= 16 && ACT_COUNT <= 16, fsm_cell_fits_in_byte);
+STATIC_ASSERT(EVT_COUNT == 10, fsm_row_matches_event_count);
+
+// 尾数已满后整数位只累加指数，到此为止不再增加 (防止 s8 回绕)
+// 此时数值至少为 10^(尾数位数 + 100)，超出所有数值后端的范围 (BCD 最大约 1E99)，换算时报溢出
+#define LEXER_EXP_MAX 100
+// 小数位 (含前导 0) 每位减一次指数，到此为止不再减少，之后的数字舍弃
+// 此时数值小于 10^(尾数位数 - 120)，即使 BCD 的 20 位尾数也小于 1E-100，低于所有数值后端的最小值，换算为 0
+#define LEXER_EXP_MIN (-120)
+// 输入预览的最大长度 (不含结束符)，与数值的格式化输出相同
+#define LEXER_STR_MAX (NUM_STR_LEN - 1)
+
+// 兼容接口使用的默认上下文 (main.c 的算式)，每次按键都会访问，放在片内直接寻址区 (data)，共 8 字节
+// (BCD 后端的尾数较大，按 NUM_MANT_MEM 放在 xdata)
+LexerCtx LEXER_CTX_MEM Lexer_Main;
 
 // ============================================================
-// 2. 动作回调 (更新返回值)
+// 2. 动作 (仅拼数类动作有副作用)
 // ============================================================
 
-// --- 数字类 (返回 TOK_NUM) ---
 /** 
  * @brief  初始化数字输入
+ * @param  ctx 词法分析上下文
  * @param  key 输入字符
- * @return 返回 TOK_NUM
+ * @return 无
  */
-static TokenType Act_InitNum(char key) {
-    val_sign = 1; current_val = (f64)(key - '0');
-    return TOK_NUM;
+static void Act_InitNum(LexerCtx LEXER_CTX_MEM *ctx, char key) {
+    ctx->sign = 1; ctx->exp = 0; ctx->inexact = 0;
+    Num_MantClear(&ctx->mant);
+    Num_MantPush(&ctx->mant, key - '0');
 }
 
 /** 
  * @brief  处理负号，初始化数字输入
- * @param  key 输入字符
- * @return 返回 TOK_NUM
+ * @param  ctx 词法分析上下文
+ * @return 无
  */
-static TokenType Act_SetSign(char key) {
-    key=0; val_sign = -1; current_val = 0.0;
-    return TOK_NUM;
+static void Act_SetSign(LexerCtx LEXER_CTX_MEM *ctx) {
+    ctx->sign = -1; ctx->exp = 0; ctx->inexact = 0;
+    Num_MantClear(&ctx->mant);
 }
 
 /** 
  * @brief  初始化小数点输入
- * @param  key 输入字符
- * @return 返回 TOK_NUM
- */
-static TokenType Act_InitDot(char key) {
-    key=0; val_sign = 1; current_val = 0.0; frac_scale = 0.1;
-    return TOK_NUM;
-}
-
-/** 
- * @brief  在整数部分添加一位数字
- * @param  key 输入字符
- * @return 返回 TOK_NUM
- */
-static TokenType Act_AddInt(char key) {
-    current_val = current_val * 10.0 + (key - '0');
-    return TOK_NUM;
-}
-
-/** 
- * @brief  在小数部分添加一位数字
- * @param  key 输入字符
- * @return 返回 TOK_NUM
+ * @param  ctx 词法分析上下文
+ * @return 无
  */
-static TokenType Act_ToDot(char key) {
-    key=0; frac_scale = 0.1;
-    return TOK_NUM;
+static void Act_InitDot(LexerCtx LEXER_CTX_MEM *ctx) {
+    ctx->sign = 1; ctx->exp = 0; ctx->inexact = 0;
+    Num_MantClear(&ctx->mant);
 }
 
 /** 
- * @brief  在小数部分添加一位数字
+ * @brief  在整数部分添加一位数字 (尾数已满时只记指数，保持数量级；指数到 LEXER_EXP_MAX 后饱和)
+ * @param  ctx 词法分析上下文
  * @param  key 输入字符
- * @return 返回 TOK_NUM
+ * @return 无
  */
-static TokenType Act_AddFrac(char key) {
-    current_val = current_val + ((key - '0') * frac_scale);
-    frac_scale *= 0.1;
-    return TOK_NUM;
+static void Act_AddInt(LexerCtx LEXER_CTX_MEM *ctx, char key) {
+    u8 d = key - '0';
+    if (!Num_MantPush(&ctx->mant, d)) {
+        if (ctx->exp < LEXER_EXP_MAX) ctx->exp++;
+        if (d) ctx->inexact = 1;
+    }
 }
 
 /** 
- * @brief  忽略无效输入
+ * @brief  在小数部分添加一位数字 (尾数已满或指数已到 LEXER_EXP_MIN 时舍弃该位)
+ * @param  ctx 词法分析上下文
  * @param  key 输入字符
- * @return 返回 TOK_NUM (保持状态)
+ * @return 无
  */
-static TokenType Act_Ignore(char key) {
-    key=0; return TOK_NUM;
+static void Act_AddFrac(LexerCtx LEXER_CTX_MEM *ctx, char key) {
+    u8 d = key - '0';
+    if (ctx->exp > LEXER_EXP_MIN && Num_MantPush(&ctx->mant, d)) {
+        ctx->exp--;
+    } else if (d) {
+        ctx->inexact = 1;
+    }
 }
 
-// --- 算符类 (返回具体 Token) ---
-/** 
- * @brief  处理加法运算符
- * @param  key 输入字符
- * @return 返回 TOK_ADD
- */
-static TokenType Act_OpAdd(char key) { key=0; return TOK_ADD; }
-
-/** 
- * @brief  处理减法运算符
- * @param  key 输入字符
- * @return 返回 TOK_SUB
- */
-static TokenType Act_OpSub(char key) { key=0; return TOK_SUB; }
-
-/** 
- * @brief  处理乘法运算符
- * @param  key 输入字符
- * @return 返回 TOK_MUL
- */
-static TokenType Act_OpMul(char key) { key=0; return TOK_MUL; }
-
-/** 
- * @brief  处理除法运算符
- * @param  key 输入字符
- * @return 返回 TOK_DIV
- */
-static TokenType Act_OpDiv(char key) { key=0; return TOK_DIV; }
-
-/** 
- * @brief  处理左括号运算符
- * @param  key 输入字符
- * @return 返回 TOK_LPAREN
- */
-static TokenType Act_OpLPa(char key) { key=0; return TOK_LPAREN; }
-
-/** 
- * @brief  处理右括号运算符
- * @param  key 输入字符
- * @return 返回 TOK_RPAREN
- */
-static TokenType Act_OpRPa(char key) { key=0; return TOK_RPAREN; }
-
-/** 
- * @brief  处理结束符运算符
- * @param  key 输入字符
- * @return 返回 TOK_END
- */
-static TokenType Act_OpEnd(char key) { key=0; return TOK_END; } 
-
-/** 
- * @brief  处理错误输入
- * @param  key 输入字符
- * @return 返回 TOK_ERROR
- */
-static TokenType Act_Error(char key) { key=0; return TOK_ERROR; }
-
 // ============================================================
-// 3. FSM 表
+// 3. FSM 表 ([状态][事件] 直接索引)
 // ============================================================
-static FSM_Item code FSM_Table[] = {
-    // ----------------------------------------------------------------------
-    //  当前状态      事件          下个状态      动作
-    // ----------------------------------------------------------------------
-    
+static u8 code FSM_Table[][EVT_COUNT] = {
     // === 1. IDLE 态 (空闲/刚开始) ===
-    // 拼数逻辑
-    {STATE_IDLE,    EVT_DIGIT,    STATE_INT,    Act_InitNum},   // 0-9 -> 记数
-    {STATE_IDLE,    EVT_DOT,      STATE_DOT,    Act_InitDot},   // .   -> 记数(0.)
-    {STATE_IDLE,    EVT_MINUS,    STATE_INT,    Act_SetSign},   // -   -> 记数(负号)
-    
-    // 算符逻辑 (IDLE下直接返回算符，状态不变)
-    {STATE_IDLE,    EVT_PLUS,     STATE_IDLE,   Act_OpAdd},
-    {STATE_IDLE,    EVT_MUL,      STATE_IDLE,   Act_OpMul},
-    {STATE_IDLE,    EVT_DIV,      STATE_IDLE,   Act_OpDiv},
-    {STATE_IDLE,    EVT_LPAREN,   STATE_IDLE,   Act_OpLPa},
-    {STATE_IDLE,    EVT_RPAREN,   STATE_IDLE,   Act_OpRPa},
-    {STATE_IDLE,    EVT_END,      STATE_IDLE,   Act_OpEnd},
+    FSM_ROW(
+        CELL(STATE_INT,   ACT_INIT_NUM),    // 0-9 -> 记数
+        CELL(STATE_DOT,   ACT_INIT_DOT),    // .   -> 记数(0.)
+        CELL(STATE_INT,   ACT_SET_SIGN),    // -   -> 记数(负号)
+        CELL(STATE_IDLE,  ACT_OP_ADD),      // 算符 (IDLE下直接返回算符，状态不变)
+        CELL(STATE_IDLE,  ACT_OP_MUL),
+        CELL(STATE_IDLE,  ACT_OP_DIV),
+        CELL(STATE_IDLE,  ACT_OP_LPA),
+        CELL(STATE_IDLE,  ACT_OP_RPA),
+        CELL(STATE_IDLE,  ACT_OP_END),
+        CELL(STATE_IDLE,  ACT_ERROR)        // 非法字符，状态不变
+    ),
 
     // === 2. INT 态 (正在输整数) ===
-    // 拼数逻辑
-    {STATE_INT,     EVT_DIGIT,    STATE_INT,    Act_AddInt},    // 0-9 -> 累加
-    {STATE_INT,     EVT_DOT,      STATE_DOT,    Act_ToDot},     // .   -> 切模式
-    
-    // 算符逻辑 (数字结束 -> 返回算符 -> 状态归零)
-    {STATE_INT,     EVT_MINUS,    STATE_IDLE,   Act_OpSub},     // - 变减号!
-    {STATE_INT,     EVT_PLUS,     STATE_IDLE,   Act_OpAdd},
-    {STATE_INT,     EVT_MUL,      STATE_IDLE,   Act_OpMul},
-    {STATE_INT,     EVT_DIV,      STATE_IDLE,   Act_OpDiv},
-    {STATE_INT,     EVT_LPAREN,   STATE_IDLE,   Act_OpLPa},     // 12( -> 12 * ( ? 暂按普通处理
-    {STATE_INT,     EVT_RPAREN,   STATE_IDLE,   Act_OpRPa},
-    {STATE_INT,     EVT_END,      STATE_IDLE,   Act_OpEnd},
+    FSM_ROW(
+        CELL(STATE_INT,   ACT_ADD_INT),     // 0-9 -> 累加
+        CELL(STATE_DOT,   ACT_IGNORE),      // .   -> 切模式 (尾数不变)
+        CELL(STATE_IDLE,  ACT_OP_SUB),      // -   -> 变减号! (数字结束 -> 返回算符 -> 状态归零)
+        CELL(STATE_IDLE,  ACT_OP_ADD),
+        CELL(STATE_IDLE,  ACT_OP_MUL),
+        CELL(STATE_IDLE,  ACT_OP_DIV),
+        CELL(STATE_IDLE,  ACT_OP_LPA),      // 12( -> 12 * ( ? 暂按普通处理
+        CELL(STATE_IDLE,  ACT_OP_RPA),
+        CELL(STATE_IDLE,  ACT_OP_END),
+        CELL(STATE_INT,   ACT_ERROR)
+    ),
 
     // === 3. DOT 态 (刚输完点 "12.") ===
-    // 拼数逻辑
-    {STATE_DOT,     EVT_DIGIT,    STATE_FRAC,   Act_AddFrac},   // 0-9 -> 小数
-    {STATE_DOT,     EVT_DOT,      STATE_DOT,    Act_Ignore},    // .   -> 忽略
-    
-    // 算符逻辑 (视为 12.0 处理)
-    {STATE_DOT,     EVT_MINUS,    STATE_IDLE,   Act_OpSub},
-    {STATE_DOT,     EVT_PLUS,     STATE_IDLE,   Act_OpAdd},
-    {STATE_DOT,     EVT_MUL,      STATE_IDLE,   Act_OpMul},
-    {STATE_DOT,     EVT_DIV,      STATE_IDLE,   Act_OpDiv},
-    {STATE_DOT,     EVT_LPAREN,   STATE_IDLE,   Act_OpLPa},
-    {STATE_DOT,     EVT_RPAREN,   STATE_IDLE,   Act_OpRPa},
-    {STATE_DOT,     EVT_END,      STATE_IDLE,   Act_OpEnd},
+    FSM_ROW(
+        CELL(STATE_FRAC,  ACT_ADD_FRAC),    // 0-9 -> 小数
+        CELL(STATE_DOT,   ACT_IGNORE),      // .   -> 忽略
+        CELL(STATE_IDLE,  ACT_OP_SUB),      // 算符 (视为 12.0 处理)
+        CELL(STATE_IDLE,  ACT_OP_ADD),
+        CELL(STATE_IDLE,  ACT_OP_MUL),
+        CELL(STATE_IDLE,  ACT_OP_DIV),
+        CELL(STATE_IDLE,  ACT_OP_LPA),
+        CELL(STATE_IDLE,  ACT_OP_RPA),
+        CELL(STATE_IDLE,  ACT_OP_END),
+        CELL(STATE_DOT,   ACT_ERROR)
+    ),
 
     // === 4. FRAC 态 (正在输小数 "12.3") ===
-    // 拼数逻辑
-    {STATE_FRAC,    EVT_DIGIT,    STATE_FRAC,   Act_AddFrac},   // 0-9 -> 累加
-    {STATE_FRAC,    EVT_DOT,      STATE_FRAC,   Act_Ignore},    // .   -> 忽略
-    
-    // 算符逻辑 (数字结束)
-    {STATE_FRAC,    EVT_MINUS,    STATE_IDLE,   Act_OpSub},
-    {STATE_FRAC,    EVT_PLUS,     STATE_IDLE,   Act_OpAdd},
-    {STATE_FRAC,    EVT_MUL,      STATE_IDLE,   Act_OpMul},
-    {STATE_FRAC,    EVT_DIV,      STATE_IDLE,   Act_OpDiv},
-    {STATE_FRAC,    EVT_LPAREN,   STATE_IDLE,   Act_OpLPa},
-    {STATE_FRAC,    EVT_RPAREN,   STATE_IDLE,   Act_OpRPa},
-    {STATE_FRAC,    EVT_END,      STATE_IDLE,   Act_OpEnd},
+    FSM_ROW(
+        CELL(STATE_FRAC,  ACT_ADD_FRAC),    // 0-9 -> 累加
+        CELL(STATE_FRAC,  ACT_IGNORE),      // .   -> 忽略
+        CELL(STATE_IDLE,  ACT_OP_SUB),      // 算符 (数字结束)
+        CELL(STATE_IDLE,  ACT_OP_ADD),
+        CELL(STATE_IDLE,  ACT_OP_MUL),
+        CELL(STATE_IDLE,  ACT_OP_DIV),
+        CELL(STATE_IDLE,  ACT_OP_LPA),
+        CELL(STATE_IDLE,  ACT_OP_RPA),
+        CELL(STATE_IDLE,  ACT_OP_END),
+        CELL(STATE_FRAC,  ACT_ERROR)
+    ),
+};
+
+// 每个状态都必须有一行
+STATIC_ASSERT(sizeof(FSM_Table) / sizeof(FSM_Table[0]) == STATE_MAX, fsm_table_covers_all_states);
+
+// ============================================================
+// 4. 字符分类表 (覆盖 '(' ~ '='，区间外均为 EVT_OTHER)
+// ============================================================
+#define CLASS_FIRST  '('
+#define CLASS_LAST   '='
+
+static u8 code CharClass[] = {
+    EVT_LPAREN,   // (
+    EVT_RPAREN,   // )
+    EVT_MUL,      // *
+    EVT_PLUS,     // +
+    EVT_OTHER,    // ,
+    EVT_MINUS,    // -
+    EVT_DOT,      // .
+    EVT_DIV,      // /
+    EVT_DIGIT, EVT_DIGIT, EVT_DIGIT, EVT_DIGIT, EVT_DIGIT,   // 0-4
+    EVT_DIGIT, EVT_DIGIT, EVT_DIGIT, EVT_DIGIT, EVT_DIGIT,   // 5-9
+    EVT_OTHER,    // :
+    EVT_OTHER,    // ;
+    EVT_OTHER,    // <
+    EVT_END,      // = 是终结符事件
 };
 
-#define TABLE_SIZE (sizeof(FSM_Table) / sizeof(FSM_Item))
+STATIC_ASSERT(sizeof(CharClass) == CLASS_LAST - CLASS_FIRST + 1, char_class_covers_range);
 
 // ============================================================
-// 4. 驱动函数
+// 5. 驱动函数
 // ============================================================
 /**
- * @brief  根据输入字符获取事件类型
+ * @brief  处理一个输入字符，驱动状态机 (查表，常数时间)
+ * @param  ctx 词法分析上下文
  * @param  key 输入字符
- * @return 事件类型枚举
+ * @return TokenType 生成的令牌类型
  */
-static EventType GetEventType(char key) {
-    if (isdigit(key)) return EVT_DIGIT;
-    switch(key) {
-        case '.': return EVT_DOT;
-        case '-': return EVT_MINUS; 
-        case '+': return EVT_PLUS;
-        case '*': return EVT_MUL;
-        case '/': return EVT_DIV;
-        case '(': return EVT_LPAREN;
-        case ')': return EVT_RPAREN;
-        case '=': return EVT_END; // = 是终结符事件
-        default:  return EVT_OTHER; 
+TokenType LexerCtx_ProcessChar(LexerCtx LEXER_CTX_MEM *ctx, char key) {
+    u8 idx = (u8)key - (u8)CLASS_FIRST;     // 区间下方的字符回绕为大数
+    u8 evt = (idx < sizeof(CharClass)) ? CharClass[idx] : EVT_OTHER;
+    u8 cell = FSM_Table[ctx->state][evt];
+    u8 act = CELL_ACT(cell);
+
+    ctx->state = CELL_NEXT(cell);
+    if (act <= ACT_ERROR) {
+        return (TokenType)act;              // 算符/忽略/错误：动作码即 Token
+    }
+
+    switch (act) {
+        case ACT_INIT_NUM: Act_InitNum(ctx, key); break;
+        case ACT_SET_SIGN: Act_SetSign(ctx);      break;
+        case ACT_INIT_DOT: Act_InitDot(ctx);      break;
+        case ACT_ADD_INT:  Act_AddInt(ctx, key);  break;
+        case ACT_ADD_FRAC: Act_AddFrac(ctx, key); break;
     }
+    return TOK_NUM;
 }
 
 /**
- * @brief  处理一个输入字符，驱动状态机
- * @param  key 输入字符
- * @return TokenType 生成的令牌类型
+ * @brief  获取当前拼凑的数字值 (尾数与指数只在这里换算一次，由数值后端完成)
+ * @param  ctx 词法分析上下文
+ * @param  r   输出数值
+ * @return u8 换算结果标志 (NUM_OK / NUM_ERR_OVERFLOW / NUM_ERR_INEXACT)，
+ *            整数位过多、指数已饱和时总带 NUM_ERR_OVERFLOW (浮点后端换算为 Inf 也不例外)；
+ *            小数位过多、指数已到下限时结果为 0 并带 NUM_ERR_INEXACT
  */
-TokenType Lexer_ProcessChar(char key) {
-    EventType evt = GetEventType(key);
-    u8 i;
-
-    for (i = 0; i < TABLE_SIZE; i++) {
-        if (FSM_Table[i].cur_state == fsm_state && FSM_Table[i].evt == evt) {
-            TokenType token = FSM_Table[i].action(key);
-            fsm_state = FSM_Table[i].next_state;
-            return token;
+u8 LexerCtx_GetCurrentNum(LexerCtx LEXER_CTX_MEM *ctx, Num *r) {
+    u8 flags;
+
+    if (ctx->exp <= LEXER_EXP_MIN) {
+        Num_FromInt(r, 0);
+        return NUM_ERR_INEXACT;
+    }
+    flags = Num_FromMant(r, ctx->sign, &ctx->mant, ctx->exp);
+    if (ctx->exp >= LEXER_EXP_MAX) flags |= NUM_ERR_OVERFLOW;
+    return flags;
+}
+
+/**
+ * @brief  按输入原样格式化当前数字，供输入过程中预览 (只用整数运算，不换算为 Num)
+ *         例如 "12.50"、"-0.05"、"0.000"；超过 LEXER_STR_MAX 个字符时末尾的小数位不再显示，
+ *         整数部分放不下或前导 0 过多 (规则与结果显示相同，见 FIX_MIN_EXP) 时改用科学计数法，
+ *         尾数只显示放得下的前几位 (如 "1.2345678E+25")
+ * @param  ctx 词法分析上下文
+ * @param  buf 输出缓冲 (至少 NUM_STR_LEN 字节)
+ * @return 无
+ */
+void LexerCtx_ToString(LexerCtx LEXER_CTX_MEM *ctx, char *buf) {
+    u8 len = 0, n, k, i;
+    s16 p;                              // 整数部分的位数 (纯小数时为 0 或负数)
+
+    if (ctx->sign < 0) buf[len++] = '-';
+    n = Num_MantDigits(&ctx->mant, buf + len, LEXER_STR_MAX - len);
+    p = (s16)n + ctx->exp;
+
+    if (n == 0 || ctx->exp <= LEXER_EXP_MIN) {
+        // 0 值: 按已输入的小数位补 0，放不下时只显示 "0"
+        buf[len++] = '0';
+        if (n == 0 && ctx->exp < 0 && len + 1 - ctx->exp <= LEXER_STR_MAX) {
+            buf[len++] = '.';
+            for (k = (u8)(-ctx->exp); k > 0; k--) buf[len++] = '0';
+        }
+    } else if (ctx->exp >= 0 && len + p <= LEXER_STR_MAX) {
+        // 整数: 尾数已满后输入的整数位记在指数里，补 0
+        len += n;
+        for (k = (u8)ctx->exp; k > 0; k--) buf[len++] = '0';
+    } else if (ctx->exp < 0 && p > 0 && len + p + 2 <= LEXER_STR_MAX) {
+        // 带小数: 在第 p 位后插入小数点，放不下的小数位截去
+        if (n > LEXER_STR_MAX - len - 1) n = LEXER_STR_MAX - len - 1;
+        for (i = len + n; i > len + p; i--) buf[i] = buf[i - 1];
+        buf[len + p] = '.';
+        len += n + 1;
+    } else if (ctx->exp < 0 && p <= 0 && p - 1 >= FIX_MIN_EXP && len + 3 - p <= LEXER_STR_MAX) {
+        // 纯小数: 数字右移，前面补 "0." 与 -p 个 0，放不下的小数位截去
+        if (n > LEXER_STR_MAX - len - 2 + p) n = (u8)(LEXER_STR_MAX - len - 2 + p);
+        k = (u8)(2 - p);
+        for (i = len + n; i > len; i--) buf[i - 1 + k] = buf[i - 1];
+        buf[len++] = '0';
+        buf[len++] = '.';
+        for (; p < 0; p++) buf[len++] = '0';
+        len += n;
+    } else {
+        // 科学计数法: d.ddd E±xx，尾数截取到放得下为止，末尾的 0 省去
+        p--;
+        k = LEXER_STR_MAX - len - ((p <= -100 || p >= 100) ? 5 : 4);
+        if (k > n) k = n;
+        while (k > 1 && buf[len + k - 1] == '0') k--;
+        if (k > 1) {
+            for (i = len + k; i > len + 1; i--) buf[i] = buf[i - 1];
+            buf[len + 1] = '.';
+            len++;
+        }
+        len += k;
+        buf[len++] = 'E';
+        if (p < 0) {
+            buf[len++] = '-';
+            p = -p;
+        } else {
+            buf[len++] = '+';
+        }
+        if (p >= 100) {
+            buf[len++] = '1';
+            p -= 100;
         }
+        buf[len++] = '0' + (u8)p / 10;
+        buf[len++] = '0' + (u8)p % 10;
     }
-    return Act_Error(key); // 未匹配到，返回错误
+    buf[len] = '\0';
 }
 
 /**
- * @brief  获取当前拼凑的数字值
- * @param  无
- * @return f64 当前数字值
+ * @brief  当前输入是否已不精确
+ * @param  ctx 词法分析上下文
+ * @return u8 1 表示有非零位被舍弃，或指数已饱和 (超出所有数值后端的范围)
  */
-f64 Lexer_GetCurrentVal(void) {
-    return current_val * val_sign;
+u8 LexerCtx_IsInexact(LexerCtx LEXER_CTX_MEM *ctx) {
+    return ctx->inexact || ctx->exp >= LEXER_EXP_MAX || ctx->exp <= LEXER_EXP_MIN;
 }
 
 /**
  * @brief  获取当前状态机状态
- * @param  无
+ * @param  ctx 词法分析上下文
  * @return InputState 当前状态
  */
-InputState Lexer_GetState(void) {
-    return fsm_state;
+InputState LexerCtx_GetState(LexerCtx LEXER_CTX_MEM *ctx) {
+    return (InputState)ctx->state;
 }
 
 /**
  * @brief  AC 全部重置状态机
- * @param  无
+ * @param  ctx 词法分析上下文
  * @return 无
  */
-void Lexer_ResetAll(void) {
-    current_val = 0.0;
-    frac_scale = 0.1;
-    val_sign = 1;
-    fsm_state = STATE_IDLE;
+void LexerCtx_ResetAll(LexerCtx LEXER_CTX_MEM *ctx) {
+    Num_MantClear(&ctx->mant);
+    ctx->exp = 0;
+    ctx->inexact = 0;
+    ctx->sign = 1;
+    ctx->state = STATE_IDLE;
 }
 
 /**
  * @brief  CE 清除当前数字输入状态
- * @param  无
+ * @param  ctx 词法分析上下文
  * @return 无
  */
-void Lexer_ClearCurrent(void) {
-    Lexer_ResetAll();
+void LexerCtx_ClearCurrent(LexerCtx LEXER_CTX_MEM *ctx) {
+    LexerCtx_ResetAll(ctx);
     // 此时状态变回 IDLE，如果 Main 的 Line1 还有符号，逻辑上也是合理的
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define __LEXER_H__
 
 #include "Common.h"
+#include "Num.h"
 
 // 词法分析器的处理结果
 #define LEX_CONSUMED  1  // 字符被词法分析器吃掉了（是数字或部分）
@@ -16,11 +17,40 @@ typedef enum {
     STATE_MAX      // 定义状态机数组的大小
 } InputState;
 
-// --- 核心接口 ---
-TokenType   Lexer_ProcessChar(char key);
-f64         Lexer_GetCurrentVal(void);
-InputState  Lexer_GetState(void);
-void        Lexer_ResetAll(void);
-void        Lexer_ClearCurrent(void);
+// 词法分析上下文：当前数字 = sign * mant * 10^exp，拼数过程只做整数运算
+// 每条独立的输入 (屏幕上的算式、串口数据流、主机上的一个线程) 各用一个上下文，互不影响；
+// 上下文放在 LEXER_CTX_MEM 区 (默认与拼数尾数相同：浮点/定点/分数为 data，BCD 为 xdata)，
+// 指针为该存储区的专用指针，访问不比原来的文件内静态变量多几条指令
+#ifndef LEXER_CTX_MEM
+#define LEXER_CTX_MEM NUM_MANT_MEM
+#endif
+
+typedef struct {
+    NumMant mant;       // 十进制尾数 (精确)，格式由数值后端决定
+    s8 exp;             // 十进制指数 (小数位为负)
+    s8 sign;
+    u8 inexact;         // 输入位数超出尾数容量，有非零位被舍弃
+    u8 state;           // InputState，按字节保存 (枚举在部分编译器下占 2 字节)
+} LexerCtx;
+
+// --- 核心接口 (显式传入上下文，可重入) ---
+TokenType   LexerCtx_ProcessChar(LexerCtx LEXER_CTX_MEM *ctx, char key);
+u8          LexerCtx_GetCurrentNum(LexerCtx LEXER_CTX_MEM *ctx, Num *r); // 返回 NUM_xxx 标志
+void        LexerCtx_ToString(LexerCtx LEXER_CTX_MEM *ctx, char *buf);  // 按输入原样预览 (只用整数运算)
+u8          LexerCtx_IsInexact(LexerCtx LEXER_CTX_MEM *ctx);    // 输入位数超出尾数精度或指数饱和时为 1
+InputState  LexerCtx_GetState(LexerCtx LEXER_CTX_MEM *ctx);
+void        LexerCtx_ResetAll(LexerCtx LEXER_CTX_MEM *ctx);     // 上下文使用前须先调用一次
+void        LexerCtx_ClearCurrent(LexerCtx LEXER_CTX_MEM *ctx);
+
+// --- 兼容接口：main.c 只有一条算式，使用默认上下文 Lexer_Main (宏展开，无额外调用开销) ---
+extern LexerCtx LEXER_CTX_MEM Lexer_Main;
+
+#define Lexer_ProcessChar(key)      LexerCtx_ProcessChar(&Lexer_Main, key)
+#define Lexer_GetCurrentNum(r)      LexerCtx_GetCurrentNum(&Lexer_Main, r)
+#define Lexer_ToString(buf)         LexerCtx_ToString(&Lexer_Main, buf)
+#define Lexer_IsInexact()           LexerCtx_IsInexact(&Lexer_Main)
+#define Lexer_GetState()            LexerCtx_GetState(&Lexer_Main)
+#define Lexer_ResetAll()            LexerCtx_ResetAll(&Lexer_Main)
+#define Lexer_ClearCurrent()        LexerCtx_ClearCurrent(&Lexer_Main)
 
 #endif
\ No newline at end of file
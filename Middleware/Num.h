@@ -0,0 +1,134 @@
+#ifndef __NUM_H__
+#define __NUM_H__
+
+#include "Common.h"
+
+/**
+ * @brief 数值抽象层：词法分析、语法分析与结果显示只通过这里操作数值，
+ *        编译时用 NUM_BACKEND 选择实现
+ */
+#define NUM_FLOAT 1     // C51 单精度软件浮点 (默认)
+#define NUM_FIXED 2     // 32 位定点十进制，值 = 整数 / 10^NUM_FIX_DIGITS
+#define NUM_BCD   3     // 压缩 BCD 十进制浮点，NUM_BCD_DIGITS 位有效数字
+#define NUM_FRAC  4     // 分数 (32 位分子/分母)，溢出时转为软件浮点
+
+#ifndef NUM_BACKEND
+#define NUM_BACKEND NUM_FLOAT
+#endif
+
+// 运算结果标志 (可按位或累积)
+#define NUM_OK            0x00
+#define NUM_ERR_DIV0      0x01  // 除数为 0
+#define NUM_ERR_OVERFLOW  0x02  // 超出表示范围 (结果已饱和)
+#define NUM_ERR_INEXACT   0x04  // 结果经过舍入 (仅提示，不算错误)
+
+#if NUM_BACKEND == NUM_FLOAT
+    // 整数优先：整数之间的 + - * 与整除直接用 32 位整数运算，溢出或除不尽时才转为浮点
+    typedef struct {
+        u8 is_int;          // 1: 值为精确整数，存于 v.i；0: 存于 v.f
+        union {
+            s32 i;
+            f64 f;
+        } v;
+    } Num;
+    #define NUM_NAME "float"
+
+#elif NUM_BACKEND == NUM_FIXED
+    // 小数位数 1~4 (缩放系数须小于 65536)，整数部分范围为 ±(2^31-1) / 10^NUM_FIX_DIGITS
+    #ifndef NUM_FIX_DIGITS
+    #define NUM_FIX_DIGITS 4
+    #endif
+    #if NUM_FIX_DIGITS == 1
+    #define NUM_FIX_SCALE 10UL
+    #elif NUM_FIX_DIGITS == 2
+    #define NUM_FIX_SCALE 100UL
+    #elif NUM_FIX_DIGITS == 3
+    #define NUM_FIX_SCALE 1000UL
+    #elif NUM_FIX_DIGITS == 4
+    #define NUM_FIX_SCALE 10000UL
+    #else
+    #error "NUM_FIX_DIGITS must be 1~4"
+    #endif
+    typedef s32 Num;
+    #define NUM_NAME "fixed"
+
+#elif NUM_BACKEND == NUM_BCD
+    // 有效数字位数 (偶数，16~20)，值 = ±0.d1d2...dN × 10^exp，exp 范围 ±NUM_BCD_EXP_MAX
+    #ifndef NUM_BCD_DIGITS
+    #define NUM_BCD_DIGITS 16
+    #endif
+    #if NUM_BCD_DIGITS < 16 || NUM_BCD_DIGITS > 20 || (NUM_BCD_DIGITS & 1)
+    #error "NUM_BCD_DIGITS must be 16, 18 or 20"
+    #endif
+    #define NUM_BCD_BYTES   (NUM_BCD_DIGITS / 2)
+    #define NUM_BCD_EXP_MAX 99
+    typedef struct {
+        u8 sign;                    // 1 表示负数
+        s8 exp;                     // 十进制指数
+        u8 d[NUM_BCD_BYTES];        // 压缩 BCD，d[0] 的高半字节为最高位；非 0 值最高位不为 0，0 值全为 0
+    } Num;
+    #define NUM_NAME "bcd"
+
+#elif NUM_BACKEND == NUM_FRAC
+    // 分数优先：值为既约分数 n/d 时精确运算 (含整数，d = 1)，任一步溢出才转为浮点
+    typedef struct {
+        u8 is_frac;         // 1: 值 = v.q.n / v.q.d (既约，d >= 1)；0: 浮点，存于 v.f
+        union {
+            struct {
+                s32 n;
+                u32 d;
+            } q;
+            f64 f;
+        } v;
+    } Num;
+    #define NUM_NAME "frac"
+
+#else
+    #error "unknown NUM_BACKEND"
+#endif
+
+// 格式化输出的最大长度 (含结束符)
+#if NUM_BACKEND == NUM_BCD || NUM_BACKEND == NUM_FRAC
+#define NUM_STR_LEN 16      // 例如 "-12345678.901234"、"1.23456789E+45"、"-1234567/654321"
+#else
+#define NUM_STR_LEN 13      // 例如 "-1.23457E-05"、"-214748.3647"
+#endif
+
+// 数值的默认存放区 (Parser 的值栈与各处的临时数值)：4~5 字节的数值放片内 (idata)，BCD 与分数较大，放片外 (xdata)
+#if NUM_BACKEND == NUM_BCD || NUM_BACKEND == NUM_FRAC
+#define NUM_MEM xdata
+#else
+#define NUM_MEM idata
+#endif
+
+u8   Num_FromInt(Num *r, s32 v);
+u8   Num_FromDigits(Num *r, s8 sign, u32 mant, s8 exp10);  // r = sign * mant * 10^exp10
+u8   Num_Add(Num *r, const Num *a, const Num *b);
+u8   Num_Sub(Num *r, const Num *a, const Num *b);
+u8   Num_Mul(Num *r, const Num *a, const Num *b);
+u8   Num_Div(Num *r, const Num *a, const Num *b);
+s8   Num_Cmp(const Num *a, const Num *b);                   // -1 / 0 / 1
+u8   Num_IsZero(const Num *a);
+void Num_ToString(const Num *a, char *buf);
+
+/**
+ * @brief 词法分析的拼数尾数：逐位追加十进制数字，最后与符号、指数一起换算为 Num
+ *        浮点/定点/分数后端为 32 位整数 (约 9 位)，BCD 后端直接按压缩 BCD 保存，可容纳 NUM_BCD_DIGITS 位
+ */
+#if NUM_BACKEND == NUM_BCD
+    typedef struct {
+        u8 len;                     // 已保存的位数 (不含前导 0)
+        u8 d[NUM_BCD_BYTES];        // 左对齐的压缩 BCD
+    } NumMant;
+    #define NUM_MANT_MEM xdata
+#else
+    typedef u32 NumMant;
+    #define NUM_MANT_MEM data
+#endif
+
+void Num_MantClear(NumMant *m);
+u8   Num_MantPush(NumMant *m, u8 d);                        // 1 成功，0 表示尾数已满
+u8   Num_MantDigits(const NumMant *m, char *buf, u8 max);   // 写出前 max 位数字字符 (无结束符)，返回总位数 (0 值为 0)
+u8   Num_FromMant(Num *r, s8 sign, const NumMant *m, s8 exp10);
+
+#endif
@@ -0,0 +1,580 @@
+/**
+ * @file    NumBcd.c
+ * @author  严嘉哲
+ * @brief   数值抽象层的压缩 BCD 十进制后端 (NUM_BACKEND == NUM_BCD)
+ *          值 = ±0.d1d2...dN × 10^exp，N = NUM_BCD_DIGITS，每字节两位十进制数；
+ *          十进制输入 (如 0.1、金额) 可精确表示，运算结果按 N 位有效数字四舍五入
+ * @version 1.0
+ * @date    2026-10-16
+ */
+#include "Num.h"
+
+#if NUM_BACKEND == NUM_BCD
+#include "Pow10.h"
+
+#define NB          NUM_BCD_BYTES   // 尾数字节数
+#define ADD_BYTES   (NB + 2)        // 加减: 尾数 + 四位保护位 (最低位兼作粘滞位)
+#define DIV_BYTES   (NB + 1)        // 除法: 余数/除数高位留一字节，商多求两位用于舍入
+#define WK_BYTES    (2 * NB)        // 乘法: 完整的 2N 位积
+
+#define FMT_FRAC_ZEROS  4           // 纯小数最多显示 4 个前导 0 (0.0000ddd)，更小用科学计数法
+
+// 运算用的工作区 (xdata)，各运算不可重入；主机编译时每个线程一份，多个线程可同时计算
+// (存储类说明符须在声明开头，_Thread_local 与 static 一起放在 WK_STATIC 中)
+#if defined(COMPILER_HOST)
+#define WK_STATIC   static _Thread_local
+#else
+#define WK_STATIC   static
+#endif
+WK_STATIC u8 xdata wk_a[WK_BYTES];
+WK_STATIC u8 xdata wk_b[WK_BYTES];
+WK_STATIC u8 xdata wk_r[WK_BYTES];
+WK_STATIC u8 xdata fmt_dg[NUM_BCD_DIGITS + 1];  // 格式化时的非压缩数字，[0] 接收舍入进位
+
+// ============================================================
+// 1. 压缩 BCD 串的基本运算 (高位在前，n 为字节数)
+// ============================================================
+
+/**
+ * @brief  d += s，逐字节做十进制调整 (相当于 ADDC 后接 DA A)
+ * @return u8 最高位的进位
+ */
+static u8 bcd_add(u8 xdata *d, u8 xdata *s, u8 n) {
+    u8 lo, hi, c = 0;
+
+    while (n--) {
+        lo = (d[n] & 0x0F) + (s[n] & 0x0F) + c;
+        hi = (d[n] >> 4) + (s[n] >> 4);
+        if (lo > 9) { lo -= 10; hi++; }
+        c = 0;
+        if (hi > 9) { hi -= 10; c = 1; }
+        d[n] = (hi << 4) | lo;
+    }
+    return c;
+}
+
+/**
+ * @brief  d -= s，逐字节十进制借位
+ * @return u8 最高位的借位
+ */
+static u8 bcd_sub(u8 xdata *d, u8 xdata *s, u8 n) {
+    u8 lo, hi, c = 0;
+
+    while (n--) {
+        lo = (d[n] & 0x0F) - (s[n] & 0x0F) - c;
+        hi = (d[n] >> 4) - (s[n] >> 4);
+        if (lo > 9) { lo += 10; hi--; }     // 无符号回绕即为借位
+        c = 0;
+        if (hi > 9) { hi += 10; c = 1; }
+        d[n] = (hi << 4) | (lo & 0x0F);
+    }
+    return c;
+}
+
+/**
+ * @brief  比较两个等长的压缩 BCD 串 (按字节比较即按数值比较)
+ * @return s8 -1 / 0 / 1
+ */
+static s8 bcd_cmp(u8 xdata *a, u8 xdata *b, u8 n) {
+    u8 i;
+    for (i = 0; i < n; i++) {
+        if (a[i] != b[i]) return (a[i] > b[i]) ? 1 : -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief  右移 k 位十进制数 (k <= 2n)，高位补 0
+ * @return u8 1 表示有非 0 数字被移出
+ */
+static u8 bcd_shr(u8 xdata *p, u8 n, u8 k) {
+    u8 i, lost = 0;
+
+    for (; k >= 2; k -= 2) {                // 整字节移动
+        lost |= p[n - 1];
+        for (i = n - 1; i > 0; i--) p[i] = p[i - 1];
+        p[0] = 0;
+    }
+    if (k) {                                // 再移半字节
+        lost |= p[n - 1] & 0x0F;
+        for (i = n - 1; i > 0; i--) p[i] = (p[i] >> 4) | (p[i - 1] << 4);
+        p[0] >>= 4;
+    }
+    return lost != 0;
+}
+
+/**
+ * @brief  左移一位十进制数，低位补 0
+ */
+static void bcd_shl1(u8 xdata *p, u8 n) {
+    u8 i;
+    for (i = 0; i + 1 < n; i++) p[i] = (p[i] << 4) | (p[i + 1] >> 4);
+    p[n - 1] <<= 4;
+}
+
+static void bcd_clear(u8 xdata *p, u8 n) {
+    while (n--) p[n] = 0;
+}
+
+static u8 bcd_is_zero(u8 xdata *p, u8 n) {
+    while (n--) {
+        if (p[n]) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief  把数值的尾数装入工作区: 工作区清 0 后从第 off 字节起放入 NB 字节尾数
+ */
+static void wk_load(u8 xdata *w, const Num *a, u8 off, u8 n) {
+    u8 i;
+    bcd_clear(w, n);
+    for (i = 0; i < NB; i++) w[off + i] = a->d[i];
+}
+
+// ============================================================
+// 2. 规格化与舍入
+// ============================================================
+
+static void num_zero(Num *r) {
+    u8 i;
+    r->sign = 0;
+    r->exp = 0;
+    for (i = 0; i < NB; i++) r->d[i] = 0;
+}
+
+/**
+ * @brief  把工作区中的结果 (值 = ±0.w × 10^e) 规格化、舍入到 N 位后写入 r
+ * @param  r      结果
+ * @param  sign   1 表示负数
+ * @param  e      十进制指数
+ * @param  w      工作区 (n >= NB 字节)
+ * @param  n      工作区字节数，超出 NB 的部分用于舍入
+ * @param  sticky 工作区之外还有被舍弃的非 0 数字
+ * @return u8 NUM_OK / NUM_ERR_INEXACT / NUM_ERR_OVERFLOW
+ */
+static u8 bcd_pack(Num *r, u8 sign, s16 e, u8 xdata *w, u8 n, u8 sticky) {
+    u8 i, j, guard = 0;
+    u8 flags = NUM_OK;
+
+    // 去掉前导 0 (先整字节，再半字节)
+    for (i = 0; i < n && w[i] == 0; i++);
+    if (i == n) {
+        num_zero(r);
+        return sticky ? NUM_ERR_INEXACT : NUM_OK;
+    }
+    if (i) {
+        for (j = 0; i + j < n; j++) w[j] = w[i + j];
+        for (; j < n; j++) w[j] = 0;
+        e -= 2 * i;
+    }
+    if (!(w[0] & 0xF0)) {
+        bcd_shl1(w, n);
+        e--;
+    }
+
+    // 第 N+1 位为舍入位，其后任一位非 0 即为粘滞位
+    if (n > NB) {
+        guard = w[NB] >> 4;
+        if (w[NB] & 0x0F) sticky = 1;
+        for (i = NB + 1; i < n; i++) {
+            if (w[i]) sticky = 1;
+        }
+    }
+    for (i = 0; i < NB; i++) r->d[i] = w[i];
+    if (guard || sticky) flags = NUM_ERR_INEXACT;
+
+    // 四舍五入: 末位加 1，逐字节向前进位
+    if (guard >= 5) {
+        for (i = NB; i > 0; i--) {
+            j = r->d[i - 1];
+            if ((j & 0x0F) != 9) { r->d[i - 1] = j + 1; break; }
+            if ((j >> 4) != 9)   { r->d[i - 1] = (j & 0xF0) + 0x10; break; }
+            r->d[i - 1] = 0;
+        }
+        if (i == 0) {                       // 0.999...9 进位为 0.1 × 10^(e+1)
+            r->d[0] = 0x10;
+            e++;
+        }
+    }
+
+    if (e > NUM_BCD_EXP_MAX) {              // 上溢: 饱和为最大值
+        for (i = 0; i < NB; i++) r->d[i] = 0x99;
+        e = NUM_BCD_EXP_MAX;
+        flags |= NUM_ERR_OVERFLOW;
+    } else if (e < -NUM_BCD_EXP_MAX) {      // 下溢: 归 0
+        num_zero(r);
+        return NUM_ERR_INEXACT;
+    }
+    r->sign = sign;
+    r->exp = (s8)e;
+    return flags;
+}
+
+/**
+ * @brief  由符号、32 位整数与指数构造数值: r = ±u × 10^exp10
+ */
+static u8 bcd_from_u32(Num *r, u8 neg, u32 u, s8 exp10) {
+    u8 i, n = 0;
+    u8 c;
+
+    bcd_clear(wk_r, NB);
+    // 逐位减法计数取出十进制数字 (最多 10 位)，跳过前导 0 后左对齐写入
+    for (i = POW10_U32_MAX + 1; i > 0; i--) {
+        c = 0;
+        while (u >= Pow10U32[i - 1]) {
+            u -= Pow10U32[i - 1];
+            c++;
+        }
+        if (c || n) {
+            wk_r[n >> 1] |= (n & 1) ? c : (c << 4);
+            n++;
+        }
+    }
+    return bcd_pack(r, neg, (s16)n + exp10, wk_r, NB, 0);
+}
+
+// ============================================================
+// 3. 数值接口
+// ============================================================
+
+/**
+ * @brief  由整数构造数值
+ * @param  r 结果
+ * @param  v 整数
+ * @return u8 NUM_OK
+ */
+u8 Num_FromInt(Num *r, s32 v) {
+    return bcd_from_u32(r, v < 0, (v < 0) ? (u32)0 - (u32)v : (u32)v, 0);
+}
+
+/**
+ * @brief  由十进制尾数与指数构造数值
+ * @param  r     结果
+ * @param  sign  符号 (负数表示负号)
+ * @param  mant  十进制尾数
+ * @param  exp10 十进制指数
+ * @return u8 NUM_OK / NUM_ERR_OVERFLOW / NUM_ERR_INEXACT
+ */
+u8 Num_FromDigits(Num *r, s8 sign, u32 mant, s8 exp10) {
+    return bcd_from_u32(r, sign < 0, mant, exp10);
+}
+
+/**
+ * @brief  加减法公共部分: r = a + (±b)，b_sign 为 b 参与运算时的符号
+ *         指数较小者右移对齐 (多保留四位)，同号相加，异号大减小
+ */
+static u8 bcd_addsub(Num *r, const Num *a, const Num *b, u8 b_sign) {
+    const Num *t;
+    u8 a_sign = a->sign;
+    u8 k, sticky;
+    u8 xdata *res = wk_a;
+    s16 e;
+
+    if (Num_IsZero(b)) {
+        *r = *a;
+        return NUM_OK;
+    }
+    if (Num_IsZero(a)) {
+        *r = *b;
+        r->sign = b_sign;
+        return NUM_OK;
+    }
+    if (a->exp < b->exp) {                  // 让 a 为指数较大者
+        t = a; a = b; b = t;
+        k = a_sign; a_sign = b_sign; b_sign = k;
+    }
+    e = a->exp;
+    k = (u8)(a->exp - b->exp);
+    if (k > 2 * ADD_BYTES) k = 2 * ADD_BYTES;
+
+    wk_load(wk_a, a, 0, ADD_BYTES);
+    wk_load(wk_b, b, 0, ADD_BYTES);
+    sticky = bcd_shr(wk_b, ADD_BYTES, k);
+    if (sticky) wk_b[ADD_BYTES - 1] |= 1;   // 移出的非 0 数字记在最低位，保证异号相减时舍入正确
+
+    if (a_sign == b_sign) {
+        if (bcd_add(wk_a, wk_b, ADD_BYTES)) {   // 进位: 右移一位，最高位补 1
+            sticky |= bcd_shr(wk_a, ADD_BYTES, 1);
+            wk_a[0] |= 0x10;
+            e++;
+        }
+    } else if (bcd_cmp(wk_a, wk_b, ADD_BYTES) >= 0) {
+        bcd_sub(wk_a, wk_b, ADD_BYTES);
+    } else {
+        bcd_sub(wk_b, wk_a, ADD_BYTES);
+        res = wk_b;
+        a_sign = b_sign;
+    }
+    return bcd_pack(r, a_sign, e, res, ADD_BYTES, sticky);
+}
+
+u8 Num_Add(Num *r, const Num *a, const Num *b) {
+    return bcd_addsub(r, a, b, b->sign);
+}
+
+u8 Num_Sub(Num *r, const Num *a, const Num *b) {
+    return bcd_addsub(r, a, b, b->sign ^ 1);
+}
+
+/**
+ * @brief  乘法: 按乘数从高到低逐位 "积左移一位，再累加被乘数 d 次"
+ *         乘数末尾的 0 不参与循环，金额类的短数只需几轮
+ */
+u8 Num_Mul(Num *r, const Num *a, const Num *b) {
+    u8 i, nd, dg;
+    u8 sign = a->sign ^ b->sign;
+
+    if (Num_IsZero(a) || Num_IsZero(b)) {
+        num_zero(r);
+        return NUM_OK;
+    }
+    // 乘数的有效位数 (去掉末尾的 0)
+    for (nd = NUM_BCD_DIGITS; nd > 0; nd--) {
+        dg = b->d[(nd - 1) >> 1];
+        if (((nd - 1) & 1) ? (dg & 0x0F) : (dg >> 4)) break;
+    }
+
+    wk_load(wk_b, a, WK_BYTES - NB, WK_BYTES);   // 被乘数右对齐
+    bcd_clear(wk_r, WK_BYTES);
+    for (i = 0; i < nd; i++) {
+        dg = b->d[i >> 1];
+        dg = (i & 1) ? (dg & 0x0F) : (dg >> 4);
+        bcd_shl1(wk_r, WK_BYTES);
+        while (dg--) bcd_add(wk_r, wk_b, WK_BYTES);
+    }
+    // 积 = A × B' (B' 为乘数去掉末尾 0 后的 nd 位) 右对齐在 2N 位工作区中，
+    // 值 = 0.(2N 位) × 10^(ea + eb + N - nd)
+    return bcd_pack(r, sign, (s16)a->exp + b->exp + NUM_BCD_DIGITS - nd, wk_r, WK_BYTES, 0);
+}
+
+/**
+ * @brief  除法: 恢复余数法，每位商用连续相减求得 (至多 9 次)，余数为 0 时提前结束；
+ *         除数为 0 时结果置 0 并返回 NUM_ERR_DIV0
+ */
+u8 Num_Div(Num *r, const Num *a, const Num *b) {
+    u8 i, q;
+    u8 sign = a->sign ^ b->sign;
+
+    if (Num_IsZero(b)) {
+        num_zero(r);
+        return NUM_ERR_DIV0;
+    }
+    if (Num_IsZero(a)) {
+        num_zero(r);
+        return NUM_OK;
+    }
+    wk_load(wk_a, a, 1, DIV_BYTES);         // 余数
+    wk_load(wk_b, b, 1, DIV_BYTES);         // 除数
+    bcd_clear(wk_r, DIV_BYTES);
+    // A/B 在 (0.1, 10) 之间，第 0 位商为个位，共求 N + 2 位
+    for (i = 0; i < NUM_BCD_DIGITS + 2; i++) {
+        q = 0;
+        while (bcd_cmp(wk_a, wk_b, DIV_BYTES) >= 0) {
+            bcd_sub(wk_a, wk_b, DIV_BYTES);
+            q++;
+        }
+        wk_r[i >> 1] |= (i & 1) ? q : (q << 4);
+        bcd_shl1(wk_a, DIV_BYTES);
+        if (bcd_is_zero(wk_a, DIV_BYTES)) break;   // 已除尽
+    }
+    return bcd_pack(r, sign, (s16)a->exp - b->exp + 1, wk_r, DIV_BYTES, !bcd_is_zero(wk_a, DIV_BYTES));
+}
+
+s8 Num_Cmp(const Num *a, const Num *b) {
+    u8 i;
+    s8 c = 0;
+
+    if (Num_IsZero(a)) {
+        if (Num_IsZero(b)) return 0;
+        return b->sign ? 1 : -1;
+    }
+    if (Num_IsZero(b)) return a->sign ? -1 : 1;
+    if (a->sign != b->sign) return a->sign ? -1 : 1;
+
+    if (a->exp != b->exp) {
+        c = (a->exp > b->exp) ? 1 : -1;
+    } else {
+        for (i = 0; i < NB; i++) {
+            if (a->d[i] != b->d[i]) {
+                c = (a->d[i] > b->d[i]) ? 1 : -1;
+                break;
+            }
+        }
+    }
+    return a->sign ? -c : c;
+}
+
+u8 Num_IsZero(const Num *a) {
+    return a->d[0] == 0;                    // 规格化后非 0 值的最高位不为 0
+}
+
+// ============================================================
+// 4. 格式化 (数字本身就是十进制，只需按位输出与舍入)
+// ============================================================
+
+/**
+ * @brief  选择输出格式
+ * @param  e     十进制指数 (值 = 0.d1d2... × 10^e)
+ * @param  k     有效数字位数
+ * @param  avail 可用字符数 (不含负号)
+ * @param  keep  输出保留的有效数字位数
+ * @return u8 1 表示用科学计数法
+ */
+static u8 fmt_layout(s16 e, u8 k, u8 avail, u8 *keep) {
+    u8 m;
+
+    if (e > 0 && e <= avail) {              // 定点，整数部分完整显示
+        if (k <= e) {
+            m = k;
+        } else if (e + 1 < avail) {
+            m = avail - 1;                  // 小数点占一位
+        } else {
+            m = (u8)e;                      // 放不下小数部分，舍入到整数
+        }
+    } else if (e <= 0 && e >= -FMT_FRAC_ZEROS) {
+        m = avail - 2 + e;                  // "0." 与前导 0
+    } else {
+        *keep = (k < avail - 6) ? k : avail - 6;    // "d." 与 "E-100"
+        return 1;
+    }
+    *keep = (k < m) ? k : m;
+    return 0;
+}
+
+/**
+ * @brief  格式化输出: 能放下时用定点表示 (如 "0.3"、"1234567.89")，
+ *         否则舍入后用科学计数法 (如 "1.23456789E+45")，不超过 NUM_STR_LEN - 1 个字符
+ */
+void Num_ToString(const Num *a, char *buf) {
+    u8 i, k, keep, sci;
+    u8 avail = NUM_STR_LEN - 1 - a->sign;
+    s16 e = a->exp;
+
+    if (Num_IsZero(a)) {
+        buf[0] = '0'; buf[1] = '\0';
+        return;
+    }
+    if (a->sign) *buf++ = '-';
+
+    // 解包为非压缩数字 fmt_dg[1..N]，并求有效位数 k
+    fmt_dg[0] = 0;
+    for (i = 0; i < NB; i++) {
+        fmt_dg[2 * i + 1] = a->d[i] >> 4;
+        fmt_dg[2 * i + 2] = a->d[i] & 0x0F;
+    }
+    for (k = NUM_BCD_DIGITS; fmt_dg[k] == 0; k--);
+
+    sci = fmt_layout(e, k, avail, &keep);
+    if (keep < k) {                         // 舍入到 keep 位
+        i = keep;
+        if (fmt_dg[keep + 1] >= 5) {
+            while (++fmt_dg[i] == 10) {
+                fmt_dg[i--] = 0;
+            }
+        }
+        k = keep;
+        if (fmt_dg[0]) {                    // 进位到最高位之前，例如 9.99 -> 10
+            fmt_dg[0] = 0;
+            fmt_dg[1] = 1;
+            k = 1;
+            e++;
+            sci = fmt_layout(e, k, avail, &keep);
+        }
+        while (fmt_dg[k] == 0) k--;
+    }
+
+    if (sci) {
+        // 科学计数法: d.ddd E±xx (指数至少两位)
+        *buf++ = '0' + fmt_dg[1];
+        if (k > 1) {
+            *buf++ = '.';
+            for (i = 2; i <= k; i++) *buf++ = '0' + fmt_dg[i];
+        }
+        e--;
+        *buf++ = 'E';
+        if (e < 0) {
+            *buf++ = '-';
+            e = -e;
+        } else {
+            *buf++ = '+';
+        }
+        if (e >= 100) {
+            *buf++ = '1';
+            e -= 100;
+        }
+        for (i = '0'; e >= 10; e -= 10) i++;
+        *buf++ = i;
+        *buf++ = '0' + (u8)e;
+    } else if (e > 0) {
+        // 整数部分 (超出有效位数的部分补 0)，再接小数部分
+        for (i = 1; i <= e; i++) *buf++ = (i <= k) ? '0' + fmt_dg[i] : '0';
+        if (k > e) {
+            *buf++ = '.';
+            for (i = (u8)e + 1; i <= k; i++) *buf++ = '0' + fmt_dg[i];
+        }
+    } else {
+        // 纯小数: 0.00ddd
+        *buf++ = '0';
+        *buf++ = '.';
+        for (; e < 0; e++) *buf++ = '0';
+        for (i = 1; i <= k; i++) *buf++ = '0' + fmt_dg[i];
+    }
+    *buf = '\0';
+}
+
+// ============================================================
+// 5. 拼数尾数 (左对齐压缩 BCD，可容纳 N 位)
+// ============================================================
+
+void Num_MantClear(NumMant *m) {
+    u8 i;
+    m->len = 0;
+    for (i = 0; i < NB; i++) m->d[i] = 0;
+}
+
+/**
+ * @brief  在尾数末尾追加一位数字 (前导 0 不占位)
+ * @return u8 1 表示追加成功，0 表示尾数已满
+ */
+u8 Num_MantPush(NumMant *m, u8 d) {
+    if (m->len == 0 && d == 0) return 1;
+    if (m->len >= NUM_BCD_DIGITS) return 0;
+    if (m->len & 1) {
+        m->d[m->len >> 1] |= d;
+    } else {
+        m->d[m->len >> 1] = d << 4;
+    }
+    m->len++;
+    return 1;
+}
+
+/**
+ * @brief  按位写出尾数的数字字符 (逐个取半字节)
+ * @param  max 最多写出的位数，其余只计数
+ * @return u8 尾数的位数 (0 值返回 0)
+ */
+u8 Num_MantDigits(const NumMant *m, char *buf, u8 max) {
+    u8 i;
+
+    for (i = 0; i < m->len && i < max; i++) {
+        buf[i] = '0' + ((i & 1) ? (m->d[i >> 1] & 0x0F) : (m->d[i >> 1] >> 4));
+    }
+    return m->len;
+}
+
+/**
+ * @brief  由拼数尾数构造数值: r = sign * m * 10^exp10 (m 为 len 位整数)
+ */
+u8 Num_FromMant(Num *r, s8 sign, const NumMant *m, s8 exp10) {
+    u8 i;
+
+    if (m->len == 0) {
+        num_zero(r);
+        return NUM_OK;
+    }
+    for (i = 0; i < NB; i++) wk_r[i] = m->d[i];
+    return bcd_pack(r, sign < 0, (s16)m->len + exp10, wk_r, NB, 0);
+}
+
+#endif
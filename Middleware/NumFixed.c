@@ -0,0 +1,269 @@
+/**
+ * @file    NumFixed.c
+ * @author  严嘉哲
+ * @brief   数值抽象层的 32 位定点后端 (NUM_BACKEND == NUM_FIXED)
+ *          值 = 整数 / 10^NUM_FIX_DIGITS，加减为单条 32 位整数运算，
+ *          乘除在操作数较小时走 32 位快路径，否则用 64 位中间结果
+ * @version 1.0
+ * @date    2026-10-16
+ */
+#include "Num.h"
+
+#if NUM_BACKEND == NUM_FIXED
+#include "Pow10.h"
+
+// 可表示的最大幅值 (不使用 -2^31，正负对称，取反不会溢出)
+#define FIX_MAX     0x7FFFFFFFUL
+#define FIX_HALF    (NUM_FIX_SCALE / 2)
+
+/**
+ * @brief  由符号与幅值组合结果，超出范围时饱和
+ * @param  r   结果
+ * @param  neg 非 0 表示负数
+ * @param  mag 幅值
+ * @return u8 NUM_OK / NUM_ERR_OVERFLOW
+ */
+static u8 fix_make(Num *r, u8 neg, u32 mag) {
+    u8 flags = NUM_OK;
+    if (mag > FIX_MAX) {
+        mag = FIX_MAX;
+        flags = NUM_ERR_OVERFLOW;
+    }
+    *r = neg ? -(s32)mag : (s32)mag;
+    return flags;
+}
+
+/**
+ * @brief  取幅值 (输入不会是 -2^31)
+ */
+static u32 fix_abs(s32 v) {
+    return (v < 0) ? (u32)-v : (u32)v;
+}
+
+/**
+ * @brief  32×32 → 64 位无符号乘法 (四次 16×16 部分积)
+ * @param  a  乘数
+ * @param  b  乘数
+ * @param  hi 积的高 32 位
+ * @return u32 积的低 32 位
+ */
+static u32 mul32x32(u32 a, u32 b, u32 *hi) {
+    u16 al = (u16)a, ah = (u16)(a >> 16);
+    u16 bl = (u16)b, bh = (u16)(b >> 16);
+    u32 ll = (u32)al * bl;
+    u32 lh = (u32)al * bh;
+    u32 hl = (u32)ah * bl;
+    u32 mid = (ll >> 16) + (u16)lh + (u16)hl;   // 至多 18 位，不会溢出
+
+    *hi = (u32)ah * bh + (lh >> 16) + (hl >> 16) + (mid >> 16);
+    return (mid << 16) | (u16)ll;
+}
+
+/**
+ * @brief  64 / 32 位无符号除法 (移位相减，要求 hi < d 以保证商为 32 位)，商四舍五入
+ *         商为 0xFFFFFFFF 时不再进位 (进位会回绕为 0)，该值已超出定点范围，由 fix_make 饱和
+ * @param  hi    被除数高 32 位
+ * @param  lo    被除数低 32 位
+ * @param  d     除数 (非 0)
+ * @param  flags 舍入时置 NUM_ERR_INEXACT
+ * @return u32 商
+ */
+static u32 div64_32(u32 hi, u32 lo, u32 d, u8 *flags) {
+    u8 i;
+    u8 carry;
+
+    for (i = 0; i < 32; i++) {
+        carry = (hi & 0x80000000UL) != 0;
+        hi = (hi << 1) | (lo >> 31);
+        lo <<= 1;
+        if (carry || hi >= d) {
+            hi -= d;
+            lo |= 1;
+        }
+    }
+    // 此时 hi 为余数
+    if (hi) {
+        *flags |= NUM_ERR_INEXACT;
+        if (hi >= d - hi && lo != 0xFFFFFFFFUL) lo++;   // 余数 >= 除数的一半，进位
+    }
+    return lo;
+}
+
+/**
+ * @brief  由整数构造数值
+ * @param  r 结果
+ * @param  v 整数
+ * @return u8 NUM_OK / NUM_ERR_OVERFLOW
+ */
+u8 Num_FromInt(Num *r, s32 v) {
+    u32 m = fix_abs(v);
+    if (m > FIX_MAX / NUM_FIX_SCALE) return fix_make(r, v < 0, FIX_MAX + 1);
+    return fix_make(r, v < 0, m * NUM_FIX_SCALE);
+}
+
+/**
+ * @brief  由十进制尾数与指数构造数值 (多余的小数位四舍五入)
+ * @param  r     结果
+ * @param  sign  符号 (负数表示负号)
+ * @param  mant  十进制尾数
+ * @param  exp10 十进制指数
+ * @return u8 NUM_OK / NUM_ERR_OVERFLOW / NUM_ERR_INEXACT
+ */
+u8 Num_FromDigits(Num *r, s8 sign, u32 mant, s8 exp10) {
+    s8 e = exp10 + NUM_FIX_DIGITS;          // 换算为定点整数后的指数
+    u32 p, q;
+
+    if (mant == 0) {
+        *r = 0;
+        return NUM_OK;
+    }
+    if (e >= 0) {
+        if (e > POW10_U32_MAX || mant > FIX_MAX / Pow10U32[e]) {
+            return fix_make(r, sign < 0, FIX_MAX + 1);
+        }
+        return fix_make(r, sign < 0, mant * Pow10U32[e]);
+    }
+    if (e < -POW10_U32_MAX) {
+        *r = 0;                             // 尾数 < 10^10，舍去后不足半个最小单位
+        return NUM_ERR_INEXACT;
+    }
+    p = Pow10U32[-e];
+    q = mant / p;
+    mant -= q * p;
+    if (mant >= p - mant) q++;
+    return fix_make(r, sign < 0, q) | (mant ? NUM_ERR_INEXACT : NUM_OK);
+}
+
+/**
+ * @brief  加法，结果超出范围时饱和并返回 NUM_ERR_OVERFLOW
+ */
+u8 Num_Add(Num *r, const Num *a, const Num *b) {
+    s32 s = (s32)((u32)*a + (u32)*b);
+    // 同号相加结果变号即溢出；-2^31 也视为溢出
+    if ((((*a ^ s) & (*b ^ s)) < 0) || s == -(s32)FIX_MAX - 1) {
+        return fix_make(r, *a < 0, FIX_MAX + 1);
+    }
+    *r = s;
+    return NUM_OK;
+}
+
+/**
+ * @brief  减法，结果超出范围时饱和并返回 NUM_ERR_OVERFLOW
+ */
+u8 Num_Sub(Num *r, const Num *a, const Num *b) {
+    Num nb = -*b;                           // 输入不会是 -2^31，取反安全
+    return Num_Add(r, a, &nb);
+}
+
+/**
+ * @brief  乘法: (a * b) / SCALE，四舍五入
+ *         两个幅值都小于 2^16 时积为 32 位，只需一次长整型除法
+ */
+u8 Num_Mul(Num *r, const Num *a, const Num *b) {
+    u32 ua = fix_abs(*a), ub = fix_abs(*b);
+    u8 neg = (*a < 0) != (*b < 0);
+    u8 flags = NUM_OK;
+    u32 lo, hi, q;
+
+    if ((ua | ub) < 0x10000UL) {
+        lo = ua * ub;
+        q = lo / NUM_FIX_SCALE;
+        lo -= q * NUM_FIX_SCALE;
+        if (lo) {
+            flags = NUM_ERR_INEXACT;
+            if (lo >= FIX_HALF) q++;
+        }
+        return fix_make(r, neg, q) | flags;
+    }
+
+    lo = mul32x32(ua, ub, &hi);
+    if (hi >= NUM_FIX_SCALE) {              // 商超出 32 位
+        return fix_make(r, neg, FIX_MAX + 1);
+    }
+    q = div64_32(hi, lo, NUM_FIX_SCALE, &flags);
+    return fix_make(r, neg, q) | flags;
+}
+
+/**
+ * @brief  除法: (a * SCALE) / b，四舍五入；除数为 0 时结果置 0 并返回 NUM_ERR_DIV0
+ *         被除数幅值不超过 0xFFFFFFFF / SCALE 时放大后仍为 32 位，只需一次长整型除法
+ */
+u8 Num_Div(Num *r, const Num *a, const Num *b) {
+    u32 ua = fix_abs(*a), ub = fix_abs(*b);
+    u8 neg = (*a < 0) != (*b < 0);
+    u8 flags = NUM_OK;
+    u32 lo, hi, q;
+
+    if (ub == 0) {
+        *r = 0;
+        return NUM_ERR_DIV0;
+    }
+
+    if (ua <= 0xFFFFFFFFUL / NUM_FIX_SCALE) {
+        lo = ua * NUM_FIX_SCALE;
+        q = lo / ub;
+        lo -= q * ub;
+        if (lo) {
+            flags = NUM_ERR_INEXACT;
+            if (lo >= ub - lo) q++;
+        }
+        return fix_make(r, neg, q) | flags;
+    }
+
+    lo = mul32x32(ua, NUM_FIX_SCALE, &hi);
+    if (hi >= ub) {                         // 商超出 32 位
+        return fix_make(r, neg, FIX_MAX + 1);
+    }
+    q = div64_32(hi, lo, ub, &flags);
+    return fix_make(r, neg, q) | flags;
+}
+
+s8 Num_Cmp(const Num *a, const Num *b) {
+    if (*a < *b) return -1;
+    return (*a > *b) ? 1 : 0;
+}
+
+u8 Num_IsZero(const Num *a) {
+    return *a == 0;
+}
+
+/**
+ * @brief  将 num 按 n 位十进制追加到 buf (高位补 0，逐位减法计数，不调用 /10 %10)
+ * @return 追加后的写入位置
+ */
+static char *put_digits(char *buf, u32 num, u8 n) {
+    char c;
+    for (; n > 0; n--) {
+        c = '0';
+        while (num >= Pow10U32[n - 1]) {
+            num -= Pow10U32[n - 1];
+            c++;
+        }
+        *buf++ = c;
+    }
+    return buf;
+}
+
+/**
+ * @brief  格式化输出，例如 "-12.5"、"3"，小数末尾的 0 省略
+ */
+void Num_ToString(const Num *a, char *buf) {
+    u32 m = fix_abs(*a);
+    u32 ip = m / NUM_FIX_SCALE;
+    u32 fp = m - ip * NUM_FIX_SCALE;
+    u8 n = 1;
+
+    if (*a < 0) *buf++ = '-';
+    while (n < POW10_U32_MAX && ip >= Pow10U32[n]) {
+        n++;
+    }
+    buf = put_digits(buf, ip, n);
+    if (fp) {
+        *buf++ = '.';
+        buf = put_digits(buf, fp, NUM_FIX_DIGITS);
+        while (buf[-1] == '0') buf--;
+    }
+    *buf = '\0';
+}
+
+#endif
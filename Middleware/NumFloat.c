@@ -0,0 +1,199 @@
+/**
+ * @file    NumFloat.c
+ * @author  严嘉哲
+ * @brief   数值抽象层的软件浮点后端 (NUM_BACKEND == NUM_FLOAT)
+ *          整数之间的运算走 32 位整数快路径，只有溢出或除不尽时才调用浮点库
+ * @version 1.1
+ * @date    2026-10-16
+ */
+#include "Num.h"
+
+#if NUM_BACKEND == NUM_FLOAT
+#include "Pow10.h"
+#include "Double2Str.h"
+#include "IntMath.h"
+
+/**
+ * @brief  取数值的浮点形式
+ */
+static f64 to_f64(const Num *a) {
+    return a->is_int ? (f64)a->v.i : a->v.f;
+}
+
+/**
+ * @brief  写入浮点结果，结果为 Inf/NaN (超出单精度范围) 时返回 NUM_ERR_OVERFLOW，与其他后端一致报溢出
+ */
+static u8 set_f64(Num *r, f64 f) {
+    r->is_int = 0;
+    r->v.f = f;
+    return (F64_Class(f) == F64_FINITE) ? NUM_OK : NUM_ERR_OVERFLOW;
+}
+
+/**
+ * @brief  写入整数结果
+ */
+static u8 set_int(Num *r, s32 i) {
+    r->is_int = 1;
+    r->v.i = i;
+    return NUM_OK;
+}
+
+/**
+ * @brief  由整数构造数值
+ * @param  r 结果
+ * @param  v 整数
+ * @return u8 NUM_OK
+ */
+u8 Num_FromInt(Num *r, s32 v) {
+    if (v == -(s32)INT_MAX_MAG - 1) return set_f64(r, (f64)v);
+    return set_int(r, v);
+}
+
+/**
+ * @brief  由十进制尾数与指数构造数值
+ *         值为 32 位以内的整数时 (含 "12.00" 这类小数位全为 0 的输入) 直接保存为整数，
+ *         否则只做一次整数转浮点，再按 10^k 整块缩放
+ * @param  r     结果
+ * @param  sign  符号 (负数表示负号)
+ * @param  mant  十进制尾数
+ * @param  exp10 十进制指数
+ * @return u8 NUM_OK / NUM_ERR_OVERFLOW (二进制浮点本就无法精确表示多数十进制小数，不单独标记舍入)
+ */
+u8 Num_FromDigits(Num *r, s8 sign, u32 mant, s8 exp10) {
+    f64 v;
+    u32 p, q;
+    u8 k;
+
+    if (mant == 0) return set_int(r, 0);
+
+    // 整数快路径
+    if (exp10 >= 0) {
+        if (exp10 <= POW10_U32_MAX && Int_MulU31(mant, Pow10U32[exp10], &q)) {
+            return set_int(r, (sign < 0) ? -(s32)q : (s32)q);
+        }
+    } else if (exp10 >= -POW10_U32_MAX) {
+        p = Pow10U32[-exp10];
+        q = mant / p;
+        if (q * p == mant && q <= INT_MAX_MAG) {
+            return set_int(r, (sign < 0) ? -(s32)q : (s32)q);
+        }
+    }
+
+    v = (f64)mant;
+    // 除以精确的 10^k 比逐位乘 0.1 少一次舍入
+    while (exp10 < 0) {
+        k = (exp10 < -POW10_F64_MAX) ? POW10_F64_MAX : (u8)(-exp10);
+        v /= Pow10F64[k];
+        exp10 += k;
+    }
+    while (exp10 > 0) {
+        k = (exp10 > POW10_F64_MAX) ? POW10_F64_MAX : (u8)exp10;
+        v *= Pow10F64[k];
+        exp10 -= k;
+    }
+    return set_f64(r, (sign < 0) ? -v : v);
+}
+
+/**
+ * @brief  加法：两个整数且不溢出时用整数运算
+ */
+u8 Num_Add(Num *r, const Num *a, const Num *b) {
+    s32 s;
+
+    if (a->is_int && b->is_int) {
+        s = (s32)((u32)a->v.i + (u32)b->v.i);
+        // 同号相加结果变号即溢出；-2^31 也按溢出处理
+        if ((((a->v.i ^ s) & (b->v.i ^ s)) >= 0) && s != -(s32)INT_MAX_MAG - 1) {
+            return set_int(r, s);
+        }
+    }
+    return set_f64(r, to_f64(a) + to_f64(b));
+}
+
+/**
+ * @brief  减法：两个整数且不溢出时用整数运算
+ */
+u8 Num_Sub(Num *r, const Num *a, const Num *b) {
+    Num nb;
+
+    if (b->is_int) {                        // 整数取反不会溢出 (不使用 -2^31)
+        nb.is_int = 1;
+        nb.v.i = -b->v.i;
+    } else {
+        nb.is_int = 0;
+        nb.v.f = -b->v.f;
+    }
+    return Num_Add(r, a, &nb);
+}
+
+/**
+ * @brief  乘法：两个整数且积不溢出时用整数运算
+ */
+u8 Num_Mul(Num *r, const Num *a, const Num *b) {
+    s32 x, y;
+    u32 p;
+
+    if (a->is_int && b->is_int) {
+        x = a->v.i;
+        y = b->v.i;
+        if (Int_MulU31((x < 0) ? (u32)-x : (u32)x, (y < 0) ? (u32)-y : (u32)y, &p)) {
+            return set_int(r, ((x < 0) != (y < 0)) ? -(s32)p : (s32)p);
+        }
+    }
+    return set_f64(r, to_f64(a) * to_f64(b));
+}
+
+/**
+ * @brief  除法：两个整数且能整除时用整数运算；除数为 0 时结果置 0 并返回 NUM_ERR_DIV0
+ */
+u8 Num_Div(Num *r, const Num *a, const Num *b) {
+    s32 x, y;
+    u32 ux, uy, q;
+
+    if (Num_IsZero(b)) {
+        set_int(r, 0);
+        return NUM_ERR_DIV0;
+    }
+    if (a->is_int && b->is_int) {
+        x = a->v.i;
+        y = b->v.i;
+        ux = (x < 0) ? (u32)-x : (u32)x;
+        uy = (y < 0) ? (u32)-y : (u32)y;
+        q = ux / uy;
+        if (q * uy == ux) {
+            return set_int(r, ((x < 0) != (y < 0)) ? -(s32)q : (s32)q);
+        }
+    }
+    return set_f64(r, to_f64(a) / to_f64(b));
+}
+
+s8 Num_Cmp(const Num *a, const Num *b) {
+    f64 x, y;
+
+    if (a->is_int && b->is_int) {
+        if (a->v.i < b->v.i) return -1;
+        return (a->v.i > b->v.i) ? 1 : 0;
+    }
+    x = to_f64(a);
+    y = to_f64(b);
+    if (x < y) return -1;
+    return (x > y) ? 1 : 0;
+}
+
+u8 Num_IsZero(const Num *a) {
+    return a->is_int ? (a->v.i == 0) : (a->v.f == 0.0);
+}
+
+/**
+ * @brief  格式化输出：整数全部位数原样输出 (见 Long2String)，
+ *         浮点保留 6 位有效数字，必要时用科学计数法 (见 Double2String)
+ */
+void Num_ToString(const Num *a, char *buf) {
+    if (a->is_int) {
+        Long2String(a->v.i, buf);
+    } else {
+        Double2String(a->v.f, buf);
+    }
+}
+
+#endif
@@ -0,0 +1,314 @@
+/**
+ * @file    NumFrac.c
+ * @author  严嘉哲
+ * @brief   数值抽象层的分数后端 (NUM_BACKEND == NUM_FRAC)
+ *          值为 32 位分子/分母的既约分数，四则运算精确 (如 (1/3+1/6)*6 = 3)，
+ *          任一步溢出时转为软件浮点继续计算
+ * @version 1.0
+ * @date    2026-10-16
+ */
+#include "Num.h"
+
+#if NUM_BACKEND == NUM_FRAC
+#include "Pow10.h"
+#include "Double2Str.h"
+#include "IntMath.h"
+
+/**
+ * @brief  取幅值 (输入不会是 -2^31)
+ */
+static u32 mag(s32 v) {
+    return (v < 0) ? (u32)-v : (u32)v;
+}
+
+/**
+ * @brief  取数值的浮点形式
+ */
+static f64 to_f64(const Num *a) {
+    return a->is_frac ? (f64)a->v.q.n / (f64)a->v.q.d : a->v.f;
+}
+
+/**
+ * @brief  写入浮点结果 (分数已放不下，结果不再精确)；结果为 Inf/NaN 时返回 NUM_ERR_OVERFLOW
+ */
+static u8 set_f64(Num *r, f64 f) {
+    r->is_frac = 0;
+    r->v.f = f;
+    return (F64_Class(f) == F64_FINITE) ? NUM_ERR_INEXACT : NUM_ERR_OVERFLOW;
+}
+
+/**
+ * @brief  写入已约分的分数 (n、d 不超过 INT_MAX_MAG，d >= 1)
+ */
+static u8 frac_store(Num *r, u8 neg, u32 n, u32 d) {
+    if (n == 0) {
+        neg = 0;
+        d = 1;
+    }
+    r->is_frac = 1;
+    r->v.q.n = neg ? -(s32)n : (s32)n;
+    r->v.q.d = d;
+    return NUM_OK;
+}
+
+/**
+ * @brief  约分后写入分数 (整数无需求 GCD)
+ */
+static u8 frac_set(Num *r, u8 neg, u32 n, u32 d) {
+    u32 g;
+
+    if (d != 1) {
+        g = Int_Gcd(n, d);
+        if (g > 1) {
+            n /= g;
+            d /= g;
+        }
+    }
+    return frac_store(r, neg, n, d);
+}
+
+/**
+ * @brief  分数加减: r = a ± b，先按分母的 GCD 通分，减小中间结果
+ * @param  b_neg 1 表示减去 b
+ * @return u8 1 表示完成，0 表示溢出 (r 未改动)
+ */
+static u8 frac_addsub(Num *r, const Num *a, const Num *b, u8 b_neg) {
+    u32 da = a->v.q.d, db = b->v.q.d;
+    u32 x = mag(a->v.q.n), y = mag(b->v.q.n);
+    u32 g, d = 1;
+    u8 neg_a = a->v.q.n < 0;
+    u8 neg_b = (b->v.q.n < 0) ^ b_neg;
+
+    if (da != 1 || db != 1) {
+        // a = x / (g*da'), b = y / (g*db')，通分为 (x*db' ± y*da') / (g*da'*db')
+        g = Int_Gcd(da, db);
+        if (!Int_MulU31(x, db / g, &x)) return 0;
+        if (!Int_MulU31(y, da / g, &y)) return 0;
+        if (!Int_MulU31(da, db / g, &d)) return 0;
+    }
+    if (neg_a == neg_b) {
+        if (x > INT_MAX_MAG - y) return 0;
+        frac_set(r, neg_a, x + y, d);
+    } else if (x >= y) {
+        frac_set(r, neg_a, x - y, d);
+    } else {
+        frac_set(r, neg_b, y - x, d);
+    }
+    return 1;
+}
+
+/**
+ * @brief  分数乘法: r = (n1/d1) × (n2/d2)，先交叉约分，积直接是既约分数
+ * @return u8 1 表示完成，0 表示溢出 (r 未改动)
+ */
+static u8 frac_mul(Num *r, u8 neg, u32 n1, u32 d1, u32 n2, u32 d2) {
+    u32 g;
+
+    if (d2 != 1) {
+        g = Int_Gcd(n1, d2);
+        if (g > 1) { n1 /= g; d2 /= g; }
+    }
+    if (d1 != 1) {
+        g = Int_Gcd(n2, d1);
+        if (g > 1) { n2 /= g; d1 /= g; }
+    }
+    if (!Int_MulU31(n1, n2, &n1)) return 0;
+    if (!Int_MulU31(d1, d2, &d1)) return 0;
+    frac_store(r, neg, n1, d1);
+    return 1;
+}
+
+/**
+ * @brief  十进制尾数与指数换算为浮点 (分数放不下时使用)
+ */
+static f64 digits_to_f64(u32 mant, s8 exp10) {
+    f64 v = (f64)mant;
+    u8 k;
+
+    while (exp10 < 0) {
+        k = (exp10 < -POW10_F64_MAX) ? POW10_F64_MAX : (u8)(-exp10);
+        v /= Pow10F64[k];
+        exp10 += k;
+    }
+    while (exp10 > 0) {
+        k = (exp10 > POW10_F64_MAX) ? POW10_F64_MAX : (u8)exp10;
+        v *= Pow10F64[k];
+        exp10 -= k;
+    }
+    return v;
+}
+
+// ============================================================
+// 数值接口
+// ============================================================
+
+/**
+ * @brief  由整数构造数值
+ * @param  r 结果
+ * @param  v 整数
+ * @return u8 NUM_OK
+ */
+u8 Num_FromInt(Num *r, s32 v) {
+    if (v == -(s32)INT_MAX_MAG - 1) {
+        set_f64(r, (f64)v);
+        return NUM_OK;                      // -2^31 在浮点下仍是精确的
+    }
+    return frac_store(r, v < 0, mag(v), 1);
+}
+
+/**
+ * @brief  由十进制尾数与指数构造数值: 小数输入即分母为 10^k 的分数 (如 0.25 = 1/4)
+ * @param  r     结果
+ * @param  sign  符号 (负数表示负号)
+ * @param  mant  十进制尾数
+ * @param  exp10 十进制指数
+ * @return u8 NUM_OK / NUM_ERR_INEXACT (超出分数范围，已转为浮点) / NUM_ERR_OVERFLOW (超出浮点范围)
+ */
+u8 Num_FromDigits(Num *r, s8 sign, u32 mant, s8 exp10) {
+    u32 n;
+    f64 v;
+
+    if (mant <= INT_MAX_MAG) {
+        if (exp10 >= 0) {
+            if (exp10 <= POW10_U32_MAX && Int_MulU31(mant, Pow10U32[exp10], &n)) {
+                return frac_store(r, sign < 0, n, 1);
+            }
+        } else if (exp10 >= -POW10_U32_MAX) {
+            return frac_set(r, sign < 0, mant, Pow10U32[-exp10]);
+        }
+    }
+    v = digits_to_f64(mant, exp10);
+    return set_f64(r, (sign < 0) ? -v : v);
+}
+
+u8 Num_Add(Num *r, const Num *a, const Num *b) {
+    if (a->is_frac && b->is_frac && frac_addsub(r, a, b, 0)) return NUM_OK;
+    return set_f64(r, to_f64(a) + to_f64(b));
+}
+
+u8 Num_Sub(Num *r, const Num *a, const Num *b) {
+    if (a->is_frac && b->is_frac && frac_addsub(r, a, b, 1)) return NUM_OK;
+    return set_f64(r, to_f64(a) - to_f64(b));
+}
+
+u8 Num_Mul(Num *r, const Num *a, const Num *b) {
+    if (a->is_frac && b->is_frac
+        && frac_mul(r, (a->v.q.n < 0) != (b->v.q.n < 0),
+                    mag(a->v.q.n), a->v.q.d, mag(b->v.q.n), b->v.q.d)) {
+        return NUM_OK;
+    }
+    return set_f64(r, to_f64(a) * to_f64(b));
+}
+
+/**
+ * @brief  除法: 乘以除数的倒数；除数为 0 时结果置 0 并返回 NUM_ERR_DIV0
+ */
+u8 Num_Div(Num *r, const Num *a, const Num *b) {
+    if (Num_IsZero(b)) {
+        frac_store(r, 0, 0, 1);
+        return NUM_ERR_DIV0;
+    }
+    if (a->is_frac && b->is_frac
+        && frac_mul(r, (a->v.q.n < 0) != (b->v.q.n < 0),
+                    mag(a->v.q.n), a->v.q.d, b->v.q.d, mag(b->v.q.n))) {
+        return NUM_OK;
+    }
+    return set_f64(r, to_f64(a) / to_f64(b));
+}
+
+/**
+ * @brief  比较: 两个分数交叉相乘比较，溢出时按浮点比较
+ */
+s8 Num_Cmp(const Num *a, const Num *b) {
+    u32 x, y;
+    f64 fa, fb;
+
+    if (a->is_frac && b->is_frac) {
+        if ((a->v.q.n < 0) != (b->v.q.n < 0)) return (a->v.q.n < 0) ? -1 : 1;
+        if (Int_MulU31(mag(a->v.q.n), b->v.q.d, &x) && Int_MulU31(mag(b->v.q.n), a->v.q.d, &y)) {
+            if (x == y) return 0;
+            return ((x > y) != (a->v.q.n < 0)) ? 1 : -1;
+        }
+    }
+    fa = to_f64(a);
+    fb = to_f64(b);
+    if (fa < fb) return -1;
+    return (fa > fb) ? 1 : 0;
+}
+
+u8 Num_IsZero(const Num *a) {
+    return a->is_frac ? (a->v.q.n == 0) : (a->v.f == 0.0);
+}
+
+// ============================================================
+// 格式化: 整数 -> "123"，有限小数 -> "0.375"，其余 -> "1/3"，放不下时按浮点显示
+// ============================================================
+
+/**
+ * @brief  十进制位数
+ */
+static u8 dec_len(u32 v) {
+    u8 n = 1;
+    while (n <= POW10_U32_MAX && v >= Pow10U32[n]) n++;
+    return n;
+}
+
+/**
+ * @brief  分母只含因子 2 和 5 时按有限小数精确输出 (长除法逐位求商)
+ * @return u8 1 表示已输出，0 表示不是有限小数或超出显示长度
+ */
+static u8 frac_to_decimal(const Num *a, char *buf) {
+    u32 n = mag(a->v.q.n);
+    u32 d = a->v.q.d;
+    u32 t = d;
+    u8 len, dg;
+
+    while (!(t & 1)) t >>= 1;
+    while (t % 5 == 0) t /= 5;
+    if (t != 1) return 0;
+
+    len = (a->v.q.n < 0) + dec_len(n / d) + 1;
+    if (len >= NUM_STR_LEN - 1) return 0;   // 至少要有一位小数
+    Long2String(a->v.q.n / (s32)d, buf);
+    if (a->v.q.n < 0 && n < d) {            // -0.5 的整数部分 "0" 需要补上负号
+        buf[0] = '-'; buf[1] = '0';
+    }
+    buf[len - 1] = '.';
+    n -= (n / d) * d;
+    while (n) {
+        if (len >= NUM_STR_LEN - 1 || n > 0xFFFFFFFFUL / 10) return 0;
+        n = (n << 3) + (n << 1);
+        for (dg = '0'; n >= d; dg++) n -= d;
+        buf[len++] = dg;
+    }
+    buf[len] = '\0';
+    return 1;
+}
+
+/**
+ * @brief  格式化输出 (不超过 NUM_STR_LEN - 1 个字符)
+ */
+void Num_ToString(const Num *a, char *buf) {
+    u8 len;
+
+    if (!a->is_frac) {
+        Double2String(a->v.f, buf);
+        return;
+    }
+    if (a->v.q.d == 1) {
+        Long2String(a->v.q.n, buf);
+        return;
+    }
+    if (frac_to_decimal(a, buf)) return;
+
+    len = (a->v.q.n < 0) + dec_len(mag(a->v.q.n));
+    if (len + 1 + dec_len(a->v.q.d) > NUM_STR_LEN - 1) {
+        Double2String(to_f64(a), buf);
+        return;
+    }
+    Long2String(a->v.q.n, buf);
+    buf[len++] = '/';
+    Long2String((s32)a->v.q.d, buf + len);
+}
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @file    NumMant.c
+ * @author  严嘉哲
+ * @brief   二进制数值后端 (浮点/定点/分数) 共用的拼数尾数：32 位整数
+ * @version 1.0
+ * @date    2026-10-16
+ */
+#include "Num.h"
+
+#if NUM_BACKEND != NUM_BCD
+#include "Pow10.h"
+
+// 尾数再追加一位不会溢出 32 位的上限 (0xFFFFFFFF / 10)
+#define MANT_SAFE   429496729UL
+
+/**
+ * @brief  清空尾数
+ */
+void Num_MantClear(NumMant *m) {
+    *m = 0;
+}
+
+/**
+ * @brief  尝试在尾数末尾追加一位数字
+ * @param  m 尾数
+ * @param  d 数字 (0~9)
+ * @return u8 1 表示追加成功，0 表示尾数已满
+ */
+u8 Num_MantPush(NumMant *m, u8 d) {
+    u32 v = *m;
+    if (v > MANT_SAFE || (v == MANT_SAFE && d > 5)) return 0;
+    // ×10 用移位相加代替长整型乘法库调用
+    *m = (v << 3) + (v << 1) + d;
+    return 1;
+}
+
+/**
+ * @brief  按位写出尾数的数字字符 (逐位减法计数，不用 32 位除法)
+ * @param  m   尾数
+ * @param  buf 输出缓冲 (不写结束符)
+ * @param  max 最多写出的位数，其余只计数
+ * @return u8 尾数的十进制位数 (0 值返回 0)
+ */
+u8 Num_MantDigits(const NumMant *m, char *buf, u8 max) {
+    u32 v = *m;
+    u8 n = 1, i;
+    char c;
+
+    if (v == 0) return 0;
+    while (n <= POW10_U32_MAX && v >= Pow10U32[n]) n++;
+    for (i = 0; i < n && i < max; i++) {
+        c = '0';
+        while (v >= Pow10U32[n - 1 - i]) {
+            v -= Pow10U32[n - 1 - i];
+            c++;
+        }
+        buf[i] = c;
+    }
+    return n;
+}
+
+/**
+ * @brief  由拼数尾数构造数值: r = sign * m * 10^exp10
+ */
+u8 Num_FromMant(Num *r, s8 sign, const NumMant *m, s8 exp10) {
+    return Num_FromDigits(r, sign, *m, exp10);
+}
+
+#endif
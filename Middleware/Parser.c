@@ -2,24 +2,23 @@
  * @file    Parser.c
  * @author  严嘉哲
  * @brief   解析器实现文件，负责表达式的语法分析和计算
- * @version 1.0
- * @date    2026-01-17
+ * @version 1.2
+ * @date    2026-10-16
  */
 #include "Parser.h"
 
-// 栈和状态
-static f64 xdata val_stack[MAX_STACK];
-static TokenType xdata op_stack[MAX_STACK];
-static s8 val_top = -1;
-static s8 op_top  = -1;
-static u8 sys_error = ERR_OK;
+// 兼容接口使用的默认上下文 (main.c 的算式)
+CalcCtx PARSER_STACK_MEM Calc_Main;
+
+STATIC_ASSERT(TOK_ERROR <= 0xFF, token_fits_in_byte);
 
 // --- 内部堆栈操作 ---
-static void push_val(f64 v) { if(val_top < MAX_STACK-1) val_stack[++val_top] = v; }
-static f64 pop_val()        { return (val_top >= 0) ? val_stack[val_top--] : 0.0; }
-static void push_op(TokenType t) { if(op_top < MAX_STACK-1) op_stack[++op_top] = t; }
-static TokenType pop_op()   { return (op_top >= 0) ? op_stack[op_top--] : TOK_END; }
-static TokenType peek_op()  { return (op_top >= 0) ? op_stack[op_top] : TOK_END; }
+#define CTX CalcCtx PARSER_STACK_MEM    // 上下文指针指向的类型 (存储区专用指针)
+
+static void push_val(CTX *c, const Num *v) { if(c->val_top < MAX_STACK-1) c->val_stack[++c->val_top] = *v; }
+static void push_op(CTX *c, TokenType t) { if(c->op_top < MAX_STACK-1) c->op_stack[++c->op_top] = (u8)t; }
+static TokenType pop_op(CTX *c)   { return (c->op_top >= 0) ? (TokenType)c->op_stack[c->op_top--] : TOK_END; }
+static TokenType peek_op(CTX *c)  { return (c->op_top >= 0) ? (TokenType)c->op_stack[c->op_top] : TOK_END; }
 
 // --- 优先表逻辑 ---
 static u8 get_idx(TokenType t) {
@@ -45,81 +44,85 @@ u8 code PriorityTable[5][5] = {
 
 /**
  * @brief  执行一次计算，根据栈顶的两个操作数和一个运算符进行计算
- * @param  无
+ *         结果直接写回次栈顶 (a)，不经过临时变量拷贝
+ * @param  c 计算上下文
  * @return 无
  */
-static void do_calculation() {
-    f64 b, a, res = 0.0;
-    TokenType op;
-    if(val_top < 1) { sys_error = ERR_SYNTAX; return; }
+static void do_calculation(CTX *c) {
+    Num *a, *b;
+    u8 flags = NUM_OK;
+    if(c->val_top < 1) { c->error = ERR_SYNTAX; return; }
     
-    b = pop_val();
-    a = pop_val();
-    op = pop_op();
+    b = &c->val_stack[c->val_top--];
+    a = &c->val_stack[c->val_top];
     
-    switch(op) {
-        case TOK_ADD: res = a + b; break;
-        case TOK_SUB: res = a - b; break;
-        case TOK_MUL: res = a * b; break;
-        case TOK_DIV: 
-            if(b == 0.0) sys_error = ERR_DIV0; 
-            else res = a / b; 
-            break;
+    switch(pop_op(c)) {
+        case TOK_ADD: flags = Num_Add(a, a, b); break;
+        case TOK_SUB: flags = Num_Sub(a, a, b); break;
+        case TOK_MUL: flags = Num_Mul(a, a, b); break;
+        case TOK_DIV: flags = Num_Div(a, a, b); break;
+        default: break;
     }
-    push_val(res);
+    if (flags & NUM_ERR_DIV0)          c->error = ERR_DIV0;
+    else if (flags & NUM_ERR_OVERFLOW) c->error = ERR_OVERFLOW;
 }
 
 // --- 外部接口 ---
 /**
  * @brief  重置计算器状态，清空操作数和运算符栈
- * @param  无
+ * @param  ctx 计算上下文
  * @return 无
  */
-void Calc_Reset(void) {
-    val_top = -1;
-    op_top = -1;
-    sys_error = ERR_OK;
-    push_op(TOK_END); // 栈底放个 = (相当于之前的 #)
+void CalcCtx_Reset(CTX *ctx) {
+    ctx->val_top = -1;
+    ctx->op_top = -1;
+    ctx->error = ERR_OK;
+    push_op(ctx, TOK_END); // 栈底放个 = (相当于之前的 #)
 }
 
 /**
  * @brief  将一个数字压入操作数栈
- * @param  val 数字值
+ * @param  ctx   计算上下文
+ * @param  val   数字值
+ * @param  flags 数字换算时数值后端返回的标志 (LexerCtx_GetCurrentNum 的返回值)，
+ *               含 NUM_ERR_OVERFLOW 时说明输入超出后端范围、val 为饱和值，置 ERR_OVERFLOW
  * @return 无
  */
-void Calc_PushNum(f64 val) {
-    push_val(val);
+void CalcCtx_PushNum(CTX *ctx, const Num *val, u8 flags) {
+    if ((flags & NUM_ERR_OVERFLOW) && ctx->error == ERR_OK) ctx->error = ERR_OVERFLOW;
+    push_val(ctx, val);
 }
 
 /**
  * @brief  将一个运算符压入运算符栈，根据优先级进行计算或移进
+ * @param  ctx      计算上下文
  * @param  input_op 输入的运算符
  * @return u8       操作是否成功，0 表示出错
  */
-u8 Calc_PushOp(TokenType input_op) {
+u8 CalcCtx_PushOp(CTX *ctx, TokenType input_op) {
     u8 row, col, relation;
     
-    if(sys_error != ERR_OK) return 0;
+    if(ctx->error != ERR_OK) return 0;
 
     while(1) {
-        TokenType stack_top = peek_op();
+        TokenType stack_top = peek_op(ctx);
         row = get_idx(stack_top);
         col = get_idx(input_op); // 注意 input_op 不变
 
         relation = PriorityTable[row][col];
 
         if (relation == 'L') { // < 移进
-            push_op(input_op);
+            push_op(ctx, input_op);
             return 1;
         } 
         else if (relation == 'G') { // > 归约 (计算)
-            do_calculation();
-            if(sys_error != ERR_OK) return 0;
+            do_calculation(ctx);
+            if(ctx->error != ERR_OK) return 0;
             // 继续循环！比如栈里是 1+2*3，来了个+，先算*，再算+
         } 
         else if (relation == 'E') { // = 匹配
             if(stack_top == TOK_LPAREN) { // 脱括号
-                pop_op();
+                pop_op(ctx);
                 return 1;
             }
             if(stack_top == TOK_END && input_op == TOK_END) { // 算完了
@@ -127,32 +130,43 @@ u8 Calc_PushOp(TokenType input_op) {
             }
         } 
         else { // X 错误
-            sys_error = ERR_SYNTAX; 
+            ctx->error = ERR_SYNTAX; 
             return 0;
         }
     }
 }
 
 /**
- * @brief  获取计算结果
- * @param  无
- * @return f64 计算结果
+ * @brief  获取计算结果 (栈空时为 0)
+ * @param  ctx 计算上下文
+ * @param  res 输出计算结果
+ * @return 无
+ */
+void CalcCtx_GetResult(CTX *ctx, Num *res) {
+    if(ctx->val_top >= 0) *res = ctx->val_stack[ctx->val_top];
+    else Num_FromInt(res, 0);
+}
+
+/**
+ * @brief  获取错误码
+ * @param  ctx 计算上下文
+ * @return u8 ERR_OK / ERR_SYNTAX / ERR_DIV0 / ERR_OVERFLOW
  */
-f64 Calc_GetResult(void) {
-    if(val_top >= 0) return val_stack[val_top];
-    return 0.0;
+u8 CalcCtx_GetError(CTX *ctx) {
+    return ctx->error;
 }
 
 /**
- * @brief  获取当前错误信息字符串
- * @param  无
+ * @brief  获取错误码对应的提示信息字符串
+ * @param  err 错误码
  * @return char* 错误信息字符串
  */
-char* Calc_GetErrorMsg(void) {
-    switch(sys_error) {
+char* Calc_ErrorMsg(u8 err) {
+    switch(err) {
         case ERR_OK:     return "OK";
         case ERR_SYNTAX: return "Syntax Error";
         case ERR_DIV0:   return "Divided By Zero";
+        case ERR_OVERFLOW: return "Overflow";
         default:         return "Error";
     }
 }
\ No newline at end of file
@@ -1,14 +1,43 @@
 #ifndef __PARSER_H__
 #define __PARSER_H__
 #include "Common.h"
+#include "Num.h"
 
 #define MAX_STACK 20
 
-// --- 核心接口 ---
-void    Calc_Reset(void);           // 重置计算器状态
-void    Calc_PushNum(f64 val);      // 压入一个数字
-u8      Calc_PushOp(TokenType op);  // 压入一个运算符
-f64     Calc_GetResult(void);       // 获取当前结果
-char*   Calc_GetErrorMsg(void);     // 获取错误信息
+// 栈所在的存储区：默认取数值后端建议的 NUM_MEM，浮点/定点为片内间接寻址区 (idata，@R0 访问，无需 DPTR)，
+// BCD 与分数数值较大，放在片外 (xdata)
+// 可改为 pdata (MOVX @Ri 分页访问)，但分页地址高字节取自 P2，本板 P2 接 LCD 控制线与蜂鸣器，
+// 使用前须确认启动代码与驱动不会改动页地址
+#ifndef PARSER_STACK_MEM
+#define PARSER_STACK_MEM NUM_MEM
+#endif
+
+// 计算上下文：一条算式的值栈、运算符栈与错误码，整体放在 PARSER_STACK_MEM 区
+// 多条算式 (或主机上的多个线程) 各用一个上下文，互不影响
+typedef struct {
+    Num val_stack[MAX_STACK];
+    u8  op_stack[MAX_STACK];    // TokenType 按字节保存
+    s8  val_top;
+    s8  op_top;
+    u8  error;                  // ERR_xxx
+} CalcCtx;
+
+// --- 核心接口 (显式传入上下文，可重入) ---
+void    CalcCtx_Reset(CalcCtx PARSER_STACK_MEM *ctx);                   // 重置计算器状态 (上下文使用前须先调用一次)
+void    CalcCtx_PushNum(CalcCtx PARSER_STACK_MEM *ctx, const Num *val, u8 flags); // 压入一个数字 (flags 为换算标志)
+u8      CalcCtx_PushOp(CalcCtx PARSER_STACK_MEM *ctx, TokenType op);    // 压入一个运算符
+void    CalcCtx_GetResult(CalcCtx PARSER_STACK_MEM *ctx, Num *res);     // 获取当前结果
+u8      CalcCtx_GetError(CalcCtx PARSER_STACK_MEM *ctx);                // 获取错误码 ERR_xxx
+char*   Calc_ErrorMsg(u8 err);                                          // 错误码对应的提示信息
+
+// --- 兼容接口：main.c 只有一条算式，使用默认上下文 Calc_Main (宏展开，无额外调用开销) ---
+extern CalcCtx PARSER_STACK_MEM Calc_Main;
+
+#define Calc_Reset()            CalcCtx_Reset(&Calc_Main)
+#define Calc_PushNum(val, flags) CalcCtx_PushNum(&Calc_Main, val, flags)
+#define Calc_PushOp(op)         CalcCtx_PushOp(&Calc_Main, op)
+#define Calc_GetResult(res)     CalcCtx_GetResult(&Calc_Main, res)
+#define Calc_GetErrorMsg()      Calc_ErrorMsg(Calc_Main.error)
 
 #endif
\ No newline at end of file
@@ -0,0 +1,17 @@
+/**
+ * @file    Pow10.c
+ * @author  严嘉哲
+ * @brief   10 的整数次幂常量表
+ * @version 1.0
+ * @date    2026-10-16
+ */
+#include "Pow10.h"
+
+u32 code Pow10U32[POW10_U32_MAX + 1] = {
+    1UL, 10UL, 100UL, 1000UL, 10000UL,
+    100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL
+};
+
+f64 code Pow10F64[POW10_F64_MAX + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10
+};
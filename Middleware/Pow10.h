@@ -0,0 +1,13 @@
+#ifndef __POW10_H__
+#define __POW10_H__
+
+#include "Common.h"
+
+// 10 的整数次幂常量表 (code 区)，词法分析、格式化与各数值后端共用
+#define POW10_U32_MAX 9     // Pow10U32[n] = 10^n，n = 0~9
+#define POW10_F64_MAX 10    // Pow10F64[n] = 10^n，n = 0~10 (单精度下均可精确表示)
+
+extern u32 code Pow10U32[POW10_U32_MAX + 1];
+extern f64 code Pow10F64[POW10_F64_MAX + 1];
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file    Stream.c
+ * @author  严嘉哲
+ * @brief   算式流：逐字符求值，每行输出一个结果 (串口协处理模式与主机批量求值共用)
+ * @version 1.0
+ * @date    2026-10-16
+ */
+#include <string.h>
+#include "Stream.h"
+
+/**
+ * @brief  绑定上下文并开始第一行
+ * @param  s     算式流
+ * @param  lexer 使用的词法分析上下文
+ * @param  calc  使用的计算上下文
+ * @return 无
+ */
+void StreamCtx_Init(StreamCtx *s, LexerCtx LEXER_CTX_MEM *lexer, CalcCtx PARSER_STACK_MEM *calc) {
+    s->lexer = lexer;
+    s->calc = calc;
+    s->done = 0;
+    s->blank = 1;
+    s->gap = 0;
+    s->error = ERR_OK;
+    LexerCtx_ResetAll(lexer);
+    CalcCtx_Reset(calc);
+}
+
+/**
+ * @brief  送入一个字符 ('\r' 忽略，空格与制表符在数字之外忽略，'\n' 结束一行)
+ * @param  s   算式流
+ * @param  c   字符
+ * @param  out 输出缓冲
+ * @return u8 STREAM_OUT 表示 out 中是本行的结果或错误信息 (错误码见 s->error)，否则 STREAM_NONE
+ */
+u8 StreamCtx_Feed(StreamCtx *s, char c, char *out) {
+    TokenType token;
+    u8 busy = 0, line_end, err, flags;
+    Num NUM_MEM val;
+
+    if (c == '\r') return STREAM_NONE;
+    line_end = (c == '\n');
+    if (s->done) {                      // 本行已有结果，跳过到行尾
+        if (line_end) StreamCtx_Init(s, s->lexer, s->calc);
+        return STREAM_NONE;
+    }
+    if (c == ' ' || c == '\t') {
+        if (LexerCtx_GetState(s->lexer) != STATE_IDLE) s->gap = 1;
+        return STREAM_NONE;
+    }
+
+    if (line_end && s->blank) {
+        token = TOK_ERROR;              // 空行
+    } else {
+        s->blank = 0;
+        if (line_end) c = '=';          // 行尾补 '='
+        busy = (LexerCtx_GetState(s->lexer) != STATE_IDLE);
+        token = LexerCtx_ProcessChar(s->lexer, c);
+        if (token == TOK_NUM) {
+            if (!s->gap) return STREAM_NONE;
+            token = TOK_ERROR;          // 空白之后的数字或小数点又接到了同一个数上
+        }
+        s->gap = 0;
+    }
+
+    if (token == TOK_ERROR) {           // 不认识的字符、数字中间的空白或空行，本行报语法错误
+        err = ERR_SYNTAX;
+    } else {
+        if (busy) {
+            flags = LexerCtx_GetCurrentNum(s->lexer, &val);
+            CalcCtx_PushNum(s->calc, &val, flags);
+        }
+        if (!CalcCtx_PushOp(s->calc, token)) {
+            err = CalcCtx_GetError(s->calc);
+        } else if (token == TOK_END) {
+            err = ERR_OK;
+        } else {
+            return STREAM_NONE;
+        }
+    }
+    if (err == ERR_OK) {
+        CalcCtx_GetResult(s->calc, &val);
+        Num_ToString(&val, out);
+    } else {
+        strcpy(out, Calc_ErrorMsg(err));
+    }
+
+    if (line_end) {
+        StreamCtx_Init(s, s->lexer, s->calc);   // 下一行
+    } else {
+        s->done = 1;
+    }
+    s->error = err;
+    return STREAM_OUT;
+}
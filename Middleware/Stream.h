@@ -0,0 +1,31 @@
+#ifndef __STREAM_H__
+#define __STREAM_H__
+
+#include "Common.h"
+#include "Lexer.h"
+#include "Parser.h"
+
+// 算式流：逐字符送入 Lexer 与 Parser，每行 (以 '\n' 结束) 给出一个结果或错误信息
+// 流程与 main.c 的按键处理相同；行内的 '=' 立即给出结果，之后到行尾的字符忽略，没有 '=' 时在行尾补上
+// 空格与制表符跳过，但不能出现在数字中间 ("12 50" 报语法错误，不会被拼成 1250)；
+// 其他不认识的字符、以及只有空白的行同样报语法错误 (不静默丢弃，以免 "12,50" 被当成 1250)
+// 串口协处理模式与主机批量求值共用，两边对同一输入逐行输出相同的文本
+typedef struct {
+    LexerCtx LEXER_CTX_MEM *lexer;
+    CalcCtx PARSER_STACK_MEM *calc;
+    u8 done;                // 本行已给出结果
+    u8 blank;               // 本行还没有非空白字符
+    u8 gap;                 // 正在拼数时遇到了空白，之后的字符不可再接到这个数上
+    u8 error;               // 本行结果的错误码 ERR_xxx (0 为正常)
+} StreamCtx;
+
+#define STREAM_NONE     0   // 没有输出
+#define STREAM_OUT      1   // out 中是本行的结果或错误信息
+
+// 输出缓冲的长度 (含结束符)：数值结果或最长的错误信息 "Divided By Zero"
+#define STREAM_OUT_LEN  ((NUM_STR_LEN > 16) ? NUM_STR_LEN : 16)
+
+void StreamCtx_Init(StreamCtx *s, LexerCtx LEXER_CTX_MEM *lexer, CalcCtx PARSER_STACK_MEM *calc);
+u8   StreamCtx_Feed(StreamCtx *s, char c, char *out);   // out 至少 STREAM_OUT_LEN 字节
+
+#endif
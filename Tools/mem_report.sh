@@ -0,0 +1,79 @@
+#!/bin/sh
+# 按模块统计 SDCC 目标文件 (.rel) 中各存储区的占用字节数，并汇总片内/片外 RAM 预算
+# 用法: [IRAM_SIZE=256] [XRAM_SIZE=1024] Tools/mem_report.sh build/small/*.rel
+#
+# 区段归类 (ASxxxx/SDCC 命名):
+#   code  : CSEG CONST HOME GSINIT GSFINAL XINIT CABS
+#   data  : DSEG OSEG REG_BANK_*
+#   idata : ISEG IABS
+#   pdata : PSEG
+#   xdata : XSEG XISEG XABS
+#   bit   : BSEG (单位: 位)
+#
+# OSEG 是可覆盖的局部变量区，链接时各模块共用同一块，预算中只计最大的一个。
+# REG_BANK_n 是工作寄存器组，每个用到它的模块都会带一份 (SDCC 各模块都输出 8 字节的 REG_BANK_0)，
+# 链接后同名的寄存器组只占一处，预算中每组只计一次 (取各模块中最大的一份)。
+
+if [ $# -eq 0 ]; then
+    echo "usage: $0 file.rel..." >&2
+    exit 1
+fi
+
+IRAM_SIZE=${IRAM_SIZE:-256}
+XRAM_SIZE=${XRAM_SIZE:-1024}
+
+awk -v iram="$IRAM_SIZE" -v xram="$XRAM_SIZE" '
+function flush() {
+    if (mod == "") return
+    printf "%-18s %6d %6d %6d %6d %6d %6d\n", mod, c, d, i, p, x, b
+    tc += c; td += d; ti += i; tp += p; tx += x; tb += b
+}
+BEGIN {
+    printf "%-18s %6s %6s %6s %6s %6s %6s\n", "module", "code", "data", "idata", "pdata", "xdata", "bit"
+}
+FNR == 1 {
+    flush()
+    mod = FILENAME; sub(/.*\//, "", mod); sub(/\.rel$/, "", mod)
+    c = d = i = p = x = b = 0
+}
+$1 == "A" && $3 == "size" {
+    n = 0; hex = toupper($4)
+    for (k = 1; k <= length(hex); k++)
+        n = n * 16 + index("0123456789ABCDEF", substr(hex, k, 1)) - 1
+    a = $2
+    if      (a ~ /^(CSEG|CONST|HOME|GSINIT|GSFINAL|XINIT|CABS)$/) c += n
+    else if (a ~ /^(DSEG|OSEG)$/ || a ~ /^REG_BANK_/) {
+        d += n
+        if (a == "OSEG") {                                      # 覆盖区另记总和与最大一块
+            osum += n
+            if (n > omax) omax = n
+        } else if (a ~ /^REG_BANK_/) {                          # 寄存器组另记总和与每组最大一份
+            rsum += n
+            if (n > rbank[a]) rbank[a] = n
+        }
+    }
+    else if (a ~ /^(ISEG|IABS)$/)                                 i += n
+    else if (a == "PSEG")                                         p += n
+    else if (a ~ /^(XSEG|XISEG|XABS)$/)                           x += n
+    else if (a == "BSEG")                                         b += n
+}
+END {
+    flush()
+    printf "%-18s %6d %6d %6d %6d %6d %6d\n", "TOTAL", tc, td, ti, tp, tx, tb
+
+    # 片内 RAM：data (覆盖区只计最大一块，寄存器组每组一次) + idata + bit 区 (按字节)，剩余部分留给堆栈
+    rmax = 0
+    for (r in rbank) rmax += rbank[r]
+    dd = td - osum + omax - rsum + rmax
+    bb = int((tb + 7) / 8)
+    used = dd + ti + bb
+    printf "\n== RAM budget (bytes) ==\n"
+    printf "%-18s %6d  (overlay %d of %d summed, register banks %d of %d summed)\n", "data", dd, omax, osum, rmax, rsum
+    printf "%-18s %6d\n", "idata", ti
+    printf "%-18s %6d  (%d bits)\n", "bit", bb, tb
+    printf "%-18s %6d / %d, %d left for stack\n", "internal RAM", used, iram, iram - used
+    printf "%-18s %6d / 256 (page 0 of xdata)\n", "pdata", tp
+    printf "%-18s %6d / %d\n", "xdata", tx + tp, xram
+    if (used > iram || tx + tp > xram) exit 1
+}
+' "$@"
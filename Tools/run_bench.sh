@@ -0,0 +1,36 @@
+#!/bin/sh
+# 在 ucsim (s51) 中运行基准测试固件，串口输出保存为 CSV
+# 用法: Tools/run_bench.sh Bench.ihx Bench.map out.csv
+#
+# 固件执行到 Bench_Done() 时命中断点，仿真结束。
+
+S51=${S51:-s51}
+XTAL=${XTAL:-12M}
+
+if [ $# -ne 3 ]; then
+    echo "usage: $0 file.ihx file.map out.csv" >&2
+    exit 1
+fi
+IHX=$1
+MAP=$2
+OUT=$3
+RAW=$OUT.raw
+
+ADDR=$(awk '{ for (i = 2; i <= NF; i++) if ($i == "_Bench_Done") print $(i - 1) }' "$MAP" | head -n 1)
+if [ -z "$ADDR" ]; then
+    echo "$0: _Bench_Done not found in $MAP" >&2
+    exit 1
+fi
+
+rm -f "$RAW"
+printf 'break 0x%s\nrun\nquit\n' "$ADDR" | \
+    "$S51" -t 8052 -X "$XTAL" -S in=/dev/null,out="$RAW" "$IHX" > /dev/null
+
+tr -d '\r' < "$RAW" > "$OUT"
+rm -f "$RAW"
+
+if ! grep -q '^# end' "$OUT"; then
+    echo "$0: benchmark output incomplete, see $OUT" >&2
+    exit 1
+fi
+cat "$OUT"
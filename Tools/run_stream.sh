@@ -0,0 +1,50 @@
+#!/bin/sh
+# 在 ucsim (s51) 中运行串口协处理固件 (UART_STREAM=1)：算式文件经模拟串口送入，回送的结果保存到文件
+# 用法: Tools/run_stream.sh MyCalculator.ihx MyCalculator.map exprs.txt out.txt
+#
+# 输入末尾补 EOT (0x04)，固件回送 "# end lost=N" 后执行到 Stream_Done() 时命中断点，仿真结束。
+# ucsim 按波特率逐字节送入，但不理会固件发出的 XOFF；固件来不及处理时会丢字节 (lost 不为 0)。
+
+S51=${S51:-s51}
+XTAL=${XTAL:-12M}
+
+if [ $# -ne 4 ]; then
+    echo "usage: $0 file.ihx file.map exprs.txt out.txt" >&2
+    exit 1
+fi
+IHX=$1
+MAP=$2
+EXPRS=$3
+OUT=$4
+IN=$OUT.in
+RAW=$OUT.raw
+
+ADDR=$(awk '{ for (i = 2; i <= NF; i++) if ($i == "_Stream_Done") print $(i - 1) }' "$MAP" | head -n 1)
+if [ -z "$ADDR" ]; then
+    echo "$0: _Stream_Done not found in $MAP (built without UART_STREAM=1?)" >&2
+    exit 1
+fi
+
+# 每行都以换行结束，最后补 EOT
+{ awk '{ print }' "$EXPRS"; printf '\004'; } > "$IN"
+
+rm -f "$RAW"
+printf 'break 0x%s\nrun\nquit\n' "$ADDR" | \
+    "$S51" -t 8052 -X "$XTAL" -S in="$IN",out="$RAW" "$IHX" > /dev/null
+
+# 去掉回车与流控字符 (XON 0x11 / XOFF 0x13)
+tr -d '\r\021\023' < "$RAW" > "$OUT.all"
+rm -f "$IN" "$RAW"
+
+END=$(grep '^# end' "$OUT.all")
+grep -v '^# end' "$OUT.all" > "$OUT"
+rm -f "$OUT.all"
+if [ -z "$END" ]; then
+    echo "$0: stream output incomplete, see $OUT" >&2
+    exit 1
+fi
+echo "$END" >&2
+if [ "$END" != "# end lost=0" ]; then
+    echo "$0: device dropped serial input" >&2
+    exit 1
+fi
@@ -9,19 +9,24 @@
 // 运算库
 #include <string.h>
 #include <ctype.h>
-#include <regx52.h>
+#include "Drivers/MCU.h"
 // 外设库
 #include "Drivers/LCD1602.h"
-#include "Drivers/Delay.h"
 #include "Drivers/Buzzer.h"
 #include "Drivers/HappyBrithday.h"
-#include "Drivers/MatrixKey.h"
-#include "Drivers/IndependentKey.h"
+#include "Drivers/KeyScan.h"
+#include "Drivers/Timer0.h"
+#include "Drivers/Scheduler.h"
+#include "Drivers/Power.h"
+#include "Drivers/Profile.h"
+#include "Drivers/Uart.h"
 // 中间件
 #include "Middleware/Common.h"
 #include "Middleware/Parser.h"
 #include "Middleware/Lexer.h"
+#include "Middleware/Num.h"
 #include "Middleware/Double2Str.h"
+#include "Middleware/Stream.h"
 
 /**
  * @brief 键盘按键映射表
@@ -40,23 +45,48 @@ u8 code KeyTable[] = {
 #define LCD_WIDTH        16
 
 static char xdata Line1_Buf[MAX_FORMULA_LEN + 1]; 
-static u8   xdata Line1_Len = 0;
-static u8   xdata last_op_index = 0; // 记录上一个 Token 结束的位置 (用于 CE/BS 回退)
+static u8   data  Line1_Len = 0;
+static u8   data  last_op_index = 0; // 记录上一个 Token 结束的位置 (用于 CE/BS 回退)
 static char xdata Line2_Buf[LCD_WIDTH + 2]; 
+STATIC_ASSERT(1 + NUM_STR_LEN <= LCD_WIDTH + 2, result_fits_line2);   // '=' + 结果
 
 static bit is_calculated = 0;   // 标记是否刚计算完结果
 static bit lexer_was_busy = 0;  // 标记处理按键前，Lexer 是否持有数字
 
+// 任务调度
+#define SPLASH_MS           1000    // 开机画面显示时长
+#define DISPLAY_PERIOD_MS   20      // 显示刷新最短间隔，连续按键的改动合并发送
+#define POWER_DOWN_MS       30000   // 无操作多久后掉电 (0 表示只用空闲模式)，须小于 65536
+
+static char data  pending_key = 0;          // 键盘任务 -> 计算任务 (0 表示无)
+static s8   data  click_key = -1;           // 键盘任务 -> 声音任务 (-1 表示无)
+static bit app_ready = 0;                   // 开机画面已结束
+static bit display_dirty = 0;               // 显存镜像有未发送的改动
+static SoftTimer xdata splash_timer;
+static SoftTimer xdata display_timer;
+static SoftTimer xdata power_timer;
+#if PROFILE
+#define PROF_COMBO_HOLD     21      // 剖析数据查看组合键：按住 CE ...
+#define PROF_COMBO_PRESS    22      // ... 再按 H
+static bit prof_key_open = 0;       // 正在测量一次按键的端到端耗时
+static bit prof_viewing = 0;        // 液晶正在显示剖析数据
+static u8  xdata prof_page = 0;
+#endif
+#if UART_STREAM
+#define STREAM_EOT          0x04    // 数据流结束 (ucsim 测试脚本在输入末尾发送)
+static bit stream_mode = 0;         // 串口协处理模式：算式来自串口，键盘只响应 AC
+static StreamCtx xdata stream;      // 使用 Lexer_Main/Calc_Main (片内 RAM 放不下第二套上下文)
+static u16 xdata stream_lines = 0;
+static u16 xdata stream_errors = 0;
+STATIC_ASSERT(STREAM_OUT_LEN <= LCD_WIDTH + 2, stream_out_fits_line2);
+#endif
+
 /**
  * @brief  显示与辅助函数
  */
 void Update_Line1() {
-    LCD_ShowString(1, 1, "                ");
-    if (Line1_Len <= LCD_WIDTH) {
-        LCD_ShowString(1, 1, Line1_Buf);
-    } else {
-        LCD_ShowString(1, 1, Line1_Buf + Line1_Len - LCD_WIDTH);
-    }
+    // 超出屏宽时由 LCD 显示移位滚动，只需追加/删除末尾字符
+    LCD_ShowLineTail(1, Line1_Buf);
 }
 
 /**
@@ -65,16 +95,21 @@ void Update_Line1() {
  * @return 无
  */
 void Update_Line2_Input() {
-    // 实时预览 Lexer 里的数值
-    Double2String(Lexer_GetCurrentVal(), Line2_Buf);
+    // 实时预览 Lexer 里的数字：直接由尾数各位与指数拼出，压栈时才换算为 Num
+    PROF_BEGIN(PROF_LEXER);
+    Lexer_ToString(Line2_Buf);
+    PROF_END(PROF_LEXER);
     
     // 视觉优化：正在输小数时，手动补个点
     if (Lexer_GetState() == STATE_DOT) {
         strcat(Line2_Buf, ".");
     }
+    // 精度提示：输入位数超出尾数容量 (多余的非零位已被舍弃)，或指数超出所有数值后端的范围
+    if (Lexer_IsInexact()) {
+        strcat(Line2_Buf, "~");
+    }
     
-    LCD_ShowString(2, 1, "                ");
-    LCD_ShowString(2, 1, Line2_Buf);
+    LCD_ShowLine(2, Line2_Buf);
 }
 
 /**
@@ -117,7 +152,7 @@ void System_Reset() {
     Line1_Buf[0] = '\0';
     
     Update_Line1();
-    LCD_ShowString(2, 1, "0               ");
+    LCD_ShowLine(2, "0");
     
     is_calculated = 0;
 }
@@ -129,6 +164,8 @@ void System_Reset() {
  */
 void OnKeyPress(char key) {
     TokenType token;
+    Num NUM_MEM val;
+    u8 ok, flags;
 
     if (is_calculated) {    // 结果态逻辑
         // 输入数字/点 -> 全局重置，开始新计算
@@ -178,7 +215,9 @@ void OnKeyPress(char key) {
     lexer_was_busy = (Lexer_GetState() != STATE_IDLE);
 
     // 让 Lexer 决定这是什么 Token
+    PROF_BEGIN(PROF_LEXER);
     token = Lexer_ProcessChar(key);
+    PROF_END(PROF_LEXER);
 
     /* Phase 3: Token 分发与处理 */
     switch (token) {
@@ -190,21 +229,27 @@ void OnKeyPress(char key) {
         // --- 情况 B: 终结符 (Terminator, 即 =) ---
         case TOK_END:
             // 1. 如果前面有数字，先压栈
+            PROF_BEGIN(PROF_PARSER);
             if (lexer_was_busy) {
-                Calc_PushNum(Lexer_GetCurrentVal());
+                flags = Lexer_GetCurrentNum(&val);
+                Calc_PushNum(&val, flags);
             }
             // 2. 压入终结符，触发 Parser 的最终归约
-            if (Calc_PushOp(TOK_END)) {
+            ok = Calc_PushOp(TOK_END);
+            PROF_END(PROF_PARSER);
+            if (ok) {
                 // 3. 获取结果并显示
-                f64 res = Calc_GetResult();
+                Calc_GetResult(&val);
                 Line1_Append('=');
                 
                 // 格式化结果到第二行
                 Line2_Buf[0] = '=';
-                Double2String(res, Line2_Buf + 1);
+                PROF_BEGIN(PROF_D2S);
+                Num_ToString(&val, Line2_Buf + 1);
+                PROF_END(PROF_D2S);
                 
                 // 右对齐显示
-                LCD_ShowString(2, 1, "                ");
+                LCD_ShowLine(2, "");
                 LCD_ShowString(2, 17 - strlen(Line2_Buf), Line2_Buf);
                 
                 // 4. 将结果回写到 Line1 缓存 (为下一次连续计算做准备)
@@ -216,7 +261,7 @@ void OnKeyPress(char key) {
             } else {
                 // 语法错误 (例如 1+*)
                 Line1_Append('=');
-                LCD_ShowString(2, 1, Calc_GetErrorMsg());
+                LCD_ShowLine(2, Calc_GetErrorMsg());
                 is_calculated = 1;
             }
             break;
@@ -228,23 +273,27 @@ void OnKeyPress(char key) {
         case TOK_LPAREN:
         case TOK_RPAREN:
             // 1. 如果前面有数字，先压栈
+            PROF_BEGIN(PROF_PARSER);
             if (lexer_was_busy) {
-                Calc_PushNum(Lexer_GetCurrentVal());
+                flags = Lexer_GetCurrentNum(&val);
+                Calc_PushNum(&val, flags);
             }
 
             // 2. 压入运算符
-            if (Calc_PushOp(token)) {
+            ok = Calc_PushOp(token);
+            PROF_END(PROF_PARSER);
+            if (ok) {
                 Line1_Append(key);
                 last_op_index = Line1_Len; // 更新符号位置，供 CE/BS 使用
                 
                 // 3. 辅助显示
-                LCD_ShowString(2, 1, "OP:             ");
+                LCD_ShowLine(2, "OP:");
                 LCD_ShowChar(2, 5, key);                
                 // 注意：Lexer 返回 Operator 时已自动 Reset，无需手动 Clear
             } else {
                 // 压栈失败 (语法错误)
                 Line1_Append(key);
-                LCD_ShowString(2, 1, Calc_GetErrorMsg());
+                LCD_ShowLine(2, Calc_GetErrorMsg());
                 is_calculated = 1;
             }
             break;
@@ -254,41 +303,265 @@ void OnKeyPress(char key) {
     }
 }
 
-void main() {
-    int key_val;
+/**
+ * @brief  键盘任务：从按键队列取一个事件，交给计算任务与声音任务
+ * @param  无
+ * @return 1 本轮有工作，0 空闲
+ */
+u8 Task_Keypad() {
+    int key_evt;
+    u8 key_val;
     char k;
-    
+
+    if (pending_key) return 0;      // 上一个键尚未处理
+    // 按键由 Timer0 中断扫描消抖，这里只取事件
+    key_evt = Key_GetEvent();
+    if (key_evt < 0) return 0;      // 无按键
+
+    key_val = key_evt & KEY_CODE_MASK;
+    k = KeyTable[key_val];
+
+    // 只有退格支持按住连发，其余键忽略连发事件
+    if ((key_evt & KEY_REPEAT) && k != 'B') return 1;
+
+#if PROFILE
+    // 隐藏组合键：按住 CE 再按 H，翻页查看剖析数据
+    if ((key_evt & KEY_MULTI) && key_val == PROF_COMBO_PRESS && Key_IsDown(PROF_COMBO_HOLD)) {
+        pending_key = 'P';
+        return 1;
+    }
+    PROF_BEGIN(PROF_KEY);
+    prof_key_open = 1;
+#endif
+
+    click_key = key_val;
+    pending_key = k;
+    SoftTimer_Start(&power_timer, POWER_DOWN_MS);
+    return 1;
+}
+
+/**
+ * @brief  计算任务：开机画面计时，之后处理一个按键
+ * @param  无
+ * @return 1 本轮有工作，0 空闲
+ */
+u8 Task_Calc() {
+    char k;
+
+    if (!app_ready) {
+        if (!SoftTimer_Expired(&splash_timer)) {
+            pending_key = 0;        // 开机画面期间的按键丢弃
+            return 0;
+        }
+        System_Reset();
+        app_ready = 1;
+        display_dirty = 1;
+        return 1;
+    }
+
+    k = pending_key;
+    if (!k) return 0;
+    pending_key = 0;
+
+#if UART_STREAM
+    if (stream_mode) {      // 协处理模式：AC 回到计算界面，其余键忽略
+        if (k == 'A') {
+            stream_mode = 0;
+            System_Reset();
+            display_dirty = 1;
+        }
+        return 1;
+    }
+#endif
+
+#if PROFILE
+    if (k == 'P') {         // 显示下一页剖析数据，翻完一轮后清零统计
+        if (!prof_viewing) prof_page = 0;
+        if (!Prof_Show(prof_page)) {
+            Prof_Reset();
+            prof_page = 0;
+            Prof_Show(prof_page);
+        }
+        prof_page++;
+        prof_viewing = 1;
+        display_dirty = 1;
+        return 1;
+    }
+    if (prof_viewing) {     // 任意键退出查看，恢复计算界面 (该键不参与计算)
+        prof_viewing = 0;
+        Update_Line1();
+        LCD_ShowLine(2, "");
+        display_dirty = 1;
+        prof_key_open = 0;
+        return 1;
+    }
+    PROF_BEGIN(PROF_CALC);
+#endif
+
+    // 快捷键处理
+    if (k == 'D') {         // Double Zero (00)
+        OnKeyPress('0'); OnKeyPress('0');
+    } else if(k == '%') {   // 百分号 (除以100)
+        OnKeyPress('/'); OnKeyPress('1'); OnKeyPress('0'); OnKeyPress('0');
+    } else if(k == 'H') {   // Happy Birthday 彩蛋 (后台播放)
+        HappyBrithday();
+    } else if(k == 'A') {   // AC 全部重置
+        System_Reset();
+    } else {                // 标准按键处理
+        OnKeyPress(k);
+    }
+    PROF_END(PROF_CALC);
+    display_dirty = 1;
+    return 1;
+}
+
+/**
+ * @brief  声音任务：播放按键音 (放入蜂鸣器队列后立即返回)
+ * @param  无
+ * @return 1 本轮有工作，0 空闲
+ */
+u8 Task_Audio() {
+    if (click_key < 0) return 0;
+    Buzzer_KeySound(click_key);
+    click_key = -1;
+    return 1;
+}
+
+#if UART_STREAM
+/**
+ * @brief  串口数据流结束点 (ucsim 在此处设断点停止仿真)
+ * @param  无
+ * @return 无
+ */
+void Stream_Done(void) {
+}
+
+/**
+ * @brief  在第二行显示已回送的行数与其中的错误数
+ * @param  无
+ * @return 无
+ */
+void Stream_ShowCount() {
+    u8 len;
+
+    Line2_Buf[0] = 'n';
+    Line2_Buf[1] = '=';
+    Long2String(stream_lines, Line2_Buf + 2);
+    len = strlen(Line2_Buf);
+    Line2_Buf[len++] = ' ';
+    Line2_Buf[len++] = 'e';
+    Line2_Buf[len++] = '=';
+    Long2String(stream_errors, Line2_Buf + len);
+    LCD_ShowLine(2, Line2_Buf);
+}
+
+/**
+ * @brief  串口任务：取一个收到的字节送入算式流，一行结束时回送结果或错误信息
+ *         收到第一个字节时进入协处理模式 (放弃屏幕上的算式)；收到 EOT 时回送结束行
+ * @param  无
+ * @return 1 本轮有工作，0 空闲
+ */
+u8 Task_Serial() {
+    int c;
+
+    if (!app_ready) return 0;
+    c = Uart_GetChar();
+    if (c < 0) return 0;
+
+    if (c == STREAM_EOT) {
+        Uart_PutString("# end lost=");
+        Long2String(Uart_LostCount(), Line2_Buf);
+        Uart_PutString(Line2_Buf);
+        Uart_PutString("\r\n");
+        Uart_Flush();
+        Stream_Done();
+        return 1;
+    }
+    if (!stream_mode) {
+        System_Reset();
+        StreamCtx_Init(&stream, &Lexer_Main, &Calc_Main);
+        stream_lines = 0;
+        stream_errors = 0;
+        stream_mode = 1;
+        LCD_ShowLine(1, "UART stream");
+    }
+    if (StreamCtx_Feed(&stream, (char)c, Line2_Buf)) {
+        Uart_PutString(Line2_Buf);
+        Uart_PutString("\r\n");
+        stream_lines++;
+        if (stream.error) stream_errors++;
+        Stream_ShowCount();
+        display_dirty = 1;
+    }
+    return 1;
+}
+#else
+#define Task_Serial()   0
+#endif
+
+/**
+ * @brief  显示任务：把显存镜像的改动交给 LCD 后台发送，最快每 DISPLAY_PERIOD_MS 一次
+ * @param  无
+ * @return 1 本轮有工作，0 空闲
+ */
+u8 Task_Display() {
+#if PROFILE
+    // 按键的改动已全部写入液晶，结束端到端计时
+    if (prof_key_open && !display_dirty && !pending_key && !LCD_IsBusy()) {
+        PROF_END(PROF_KEY);
+        prof_key_open = 0;
+    }
+#endif
+    if (!display_dirty || !Sched_Every(&display_timer, DISPLAY_PERIOD_MS)) return 0;
+    display_dirty = 0;
+    PROF_BEGIN(PROF_LCD);
+    LCD_Flush();
+    PROF_END(PROF_LCD);
+    return 1;
+}
+
+/**
+ * @brief  一轮没有任务工作时让 CPU 睡眠：通常进入空闲模式，由下一个中断唤醒；
+ *         长时间无操作且声音、显示都已结束时进入掉电模式，由 P3.2/P3.3 按键唤醒
+ * @param  无
+ * @return 无
+ */
+void Power_Sleep() {
+#if POWER_DOWN_MS && !UART_STREAM     // 掉电后只能由 INT0/INT1 唤醒，串口数据会丢失
+    if (app_ready && SoftTimer_Expired(&power_timer)
+        && !Key_AnyDown() && !Buzzer_IsBusy() && !LCD_IsBusy()) {
+        Power_Down();
+        Key_Resync();       // 唤醒用的按键不当作输入
+        SoftTimer_Start(&power_timer, POWER_DOWN_MS);
+        return;
+    }
+#endif
+    Power_Idle();
+}
+
+void main() {
     LCD_Init();
+    Key_Init();
     Buzzer_Init();
+#if UART_STREAM
+    Uart_Init();
+#endif
+#if PROFILE
+    Prof_Reset();
+#endif
     
-    // 显示startup信息
+    // 显示startup信息，由计算任务计时结束后进入计算界面
     LCD_ShowString(1, 4, "Calculator");
     LCD_ShowString(2, 11, "By YJZ");
-    Delay(1000);
-    System_Reset(); 
+    LCD_Flush();
+    SoftTimer_Start(&splash_timer, SPLASH_MS);
+    SoftTimer_Start(&power_timer, POWER_DOWN_MS);
     
+    // 协作式调度：每个任务只做一小步并立即返回，一轮都没有工作时计为空闲并睡眠到下一个中断
     while(1) {
-        // 扫描矩阵按键
-        key_val = MatrixKeyDown();
-        // 扫描独立按键
-        if(key_val < 0) key_val = IndependentKeyDown();
-        if(key_val < 0) continue; // 无按键
-        
-        Buzzer_KeySound(key_val);
-
-        k = KeyTable[key_val];
-        
-        // 快捷键处理
-        if (k == 'D') {         // Double Zero (00)
-            OnKeyPress('0'); OnKeyPress('0');
-        } else if(k == '%') {   // 百分号 (除以100)
-            OnKeyPress('/'); OnKeyPress('1'); OnKeyPress('0'); OnKeyPress('0');
-        } else if(k == 'H') {   // Happy Birthday 彩蛋
-            HappyBrithday();
-        } else if(k == 'A') {   // AC 全部重置
-            System_Reset();
-        } else {                // 标准按键处理
-            OnKeyPress(k);
+        if (!(Task_Keypad() | Task_Calc() | Task_Audio() | Task_Serial() | Task_Display())) {
+            Sched_Idle();
+            Power_Sleep();
         }
     }
-}
\ No newline at end of file
+}